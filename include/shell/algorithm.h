@@ -3,6 +3,7 @@
 #include <cstring>
 #include <cwchar>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <shell/locale.h>
@@ -44,12 +45,12 @@ std::size_t len(const String& str)
 template<typename String, typename Predicate>
 void trimLeftIf(String& str, Predicate pred)
 {
-    str.erase(
-        std::begin(str),
-        std::find_if_not(
-            std::begin(str),
-            std::end(str),
-            pred));
+    auto iter = std::find_if_not(std::begin(str), std::end(str), pred);
+
+    if constexpr (is_specialization_v<String, std::basic_string_view>)
+        str.remove_prefix(static_cast<std::size_t>(iter - std::begin(str)));
+    else
+        str.erase(std::begin(str), iter);
 }
 
 template<typename String>
@@ -78,12 +79,12 @@ String trimLeftCopy(const String& str, const std::locale& locale = std::locale()
 template<typename String, typename Predicate>
 void trimRightIf(String& str, Predicate pred)
 {
-    str.erase(
-        std::find_if_not(
-            std::rbegin(str),
-            std::rend(str),
-            pred).base(),
-        std::end(str));
+    auto iter = std::find_if_not(std::rbegin(str), std::rend(str), pred);
+
+    if constexpr (is_specialization_v<String, std::basic_string_view>)
+        str.remove_suffix(static_cast<std::size_t>(iter - std::rbegin(str)));
+    else
+        str.erase(iter.base(), std::end(str));
 }
 
 template<typename String>
@@ -251,7 +252,11 @@ String replaceCopy(const String& str, const From& from, const To& to)
     return res;
 }
 
-template<typename OutputIterator, typename String, typename Delimiter>
+template<
+    typename OutputIterator,
+    typename String,
+    typename Delimiter,
+    typename = decltype(String::npos)>
 OutputIterator splitFirst(OutputIterator out, const String& str, const Delimiter& del)
 {
     std::size_t pos = 0;
@@ -278,7 +283,24 @@ std::vector<String> splitFirst(const String& str, const Delimiter& del)
     return res;
 }
 
-template<typename OutputIterator, typename String, typename Delimiter>
+template<
+    typename String,
+    typename Delimiter,
+    typename Allocator,
+    typename = std::enable_if_t<std::is_same_v<typename Allocator::value_type, String>>>
+std::vector<String, Allocator> splitFirst(const String& str, const Delimiter& del, const Allocator& alloc)
+{
+    std::vector<String, Allocator> res(alloc);
+    splitFirst(std::back_inserter(res), str, del);
+
+    return res;
+}
+
+template<
+    typename OutputIterator,
+    typename String,
+    typename Delimiter,
+    typename = decltype(String::npos)>
 OutputIterator splitLast(OutputIterator out, const String& str, const Delimiter& del)
 {
     std::size_t pos = 0;
@@ -305,7 +327,24 @@ std::vector<String> splitLast(const String& str, const Delimiter& del)
     return res;
 }
 
-template<typename OutputIterator, typename String, typename Delimiter>
+template<
+    typename String,
+    typename Delimiter,
+    typename Allocator,
+    typename = std::enable_if_t<std::is_same_v<typename Allocator::value_type, String>>>
+std::vector<String, Allocator> splitLast(const String& str, const Delimiter& del, const Allocator& alloc)
+{
+    std::vector<String, Allocator> res(alloc);
+    splitLast(std::back_inserter(res), str, del);
+
+    return res;
+}
+
+template<
+    typename OutputIterator,
+    typename String,
+    typename Delimiter,
+    typename = decltype(String::npos)>
 OutputIterator split(OutputIterator out, const String& str, const Delimiter& del)
 {
     std::size_t pos = 0;
@@ -332,6 +371,19 @@ std::vector<String> split(const String& str, const Delimiter& del)
     return res;
 }
 
+template<
+    typename String,
+    typename Delimiter,
+    typename Allocator,
+    typename = std::enable_if_t<std::is_same_v<typename Allocator::value_type, String>>>
+std::vector<String, Allocator> split(const String& str, const Delimiter& del, const Allocator& alloc)
+{
+    std::vector<String, Allocator> res(alloc);
+    split(std::back_inserter(res), str, del);
+
+    return res;
+}
+
 template<typename Range, typename Delimiter>
 range_value_t<Range> join(const Range& range, const Delimiter& del)
 {
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
 #include <climits>
+#include <cstring>
+#include <iterator>
 
 #include <shell/int.h>
 #include <shell/macros.h>
@@ -223,11 +226,93 @@ constexpr Integral twos(Integral value)
     return ~value + 1;
 }
 
+namespace detail
+{
+
+template<typename Integral>
+constexpr Integral ror(Integral value, uint amount)
+{
+    constexpr uint kMask = bits_v<Integral> - 1;
+
+    amount &= kMask;
+    return shr(value, amount) | (value << (-amount & kMask));
+}
+
 template<typename Integral>
-Integral ror(Integral value, uint amount)
+constexpr Integral rol(Integral value, uint amount)
+{
+    constexpr uint kMask = bits_v<Integral> - 1;
+
+    amount &= kMask;
+    return (value << amount) | shr(value, -amount & kMask);
+}
+
+template<typename Integral>
+constexpr Integral byteSwap(Integral value)
+{
+    std::make_unsigned_t<Integral> result = 0;
+    for (uint i = 0; i < sizeof(Integral); ++i)
+        result = (result << CHAR_BIT) | static_cast<u8>(value >> (CHAR_BIT * i));
+
+    return static_cast<Integral>(result);
+}
+
+template<typename Integral>
+constexpr Integral bitSwap(Integral value)
+{
+    std::make_unsigned_t<Integral> result = 0;
+    for (uint i = 0; i < bits_v<Integral>; ++i)
+        result = (result << 1) | ((value >> i) & 1);
+
+    return static_cast<Integral>(result);
+}
+
+template<typename Integral>
+constexpr uint popcnt(Integral value)
+{
+    auto bits = static_cast<std::make_unsigned_t<Integral>>(value);
+
+    uint count = 0;
+    for (; bits; bits &= bits - 1)
+        ++count;
+
+    return count;
+}
+
+template<typename Integral>
+constexpr uint clz(Integral value)
+{
+    auto bits = static_cast<std::make_unsigned_t<Integral>>(value);
+
+    uint count = 0;
+    for (; (bits & (1ULL << (bits_v<Integral> - 1))) == 0; bits <<= 1)
+        ++count;
+
+    return count;
+}
+
+template<typename Integral>
+constexpr uint ctz(Integral value)
+{
+    auto bits = static_cast<std::make_unsigned_t<Integral>>(value);
+
+    uint count = 0;
+    for (; (bits & 1) == 0; bits >>= 1)
+        ++count;
+
+    return count;
+}
+
+}  // namespace detail
+
+template<typename Integral>
+constexpr Integral ror(Integral value, uint amount)
 {
     static_assert(std::is_integral_v<Integral>);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::ror(value, amount);
+
     #if SHELL_CC_MSVC
     if constexpr (sizeof(Integral) == 1) return _rotr8 (value, amount);
     if constexpr (sizeof(Integral) == 2) return _rotr16(value, amount);
@@ -239,18 +324,18 @@ Integral ror(Integral value, uint amount)
     if constexpr (sizeof(Integral) == 4) return __builtin_rotateright32(value, amount);
     if constexpr (sizeof(Integral) == 8) return __builtin_rotateright64(value, amount);
     #else
-    constexpr Integral kMask = bits_v<Integral> - 1;
-
-    amount &= kMask;
-    return shr(value, amount) | (value << (-amount & kMask));
+    return detail::ror(value, amount);
     #endif
 }
 
 template<typename Integral>
-Integral rol(Integral value, uint amount)
+constexpr Integral rol(Integral value, uint amount)
 {
     static_assert(std::is_integral_v<Integral>);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::rol(value, amount);
+
     #if SHELL_CC_MSVC
     if constexpr (sizeof(Integral) == 1) return _rotl8 (value, amount);
     if constexpr (sizeof(Integral) == 2) return _rotl16(value, amount);
@@ -262,18 +347,18 @@ Integral rol(Integral value, uint amount)
     if constexpr (sizeof(Integral) == 4) return __builtin_rotateleft32(value, amount);
     if constexpr (sizeof(Integral) == 8) return __builtin_rotateleft64(value, amount);
     #else
-    constexpr Integral kMask = bits_v<Integral> - 1;
-
-    amount &= kMask;
-    return (value << amount) | shr(value, -amount & kMask);
+    return detail::rol(value, amount);
     #endif
 }
 
 template<typename Integral>
-Integral byteSwap(Integral value)
+constexpr Integral byteSwap(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::byteSwap(value);
+
     if constexpr (sizeof(Integral) == 1) return value;
     #if SHELL_CC_MSVC
     if constexpr (sizeof(Integral) == 2) return _byteswap_ushort(value);
@@ -287,10 +372,13 @@ Integral byteSwap(Integral value)
 }
 
 template<typename Integral>
-Integral bitSwap(Integral value)
+constexpr Integral bitSwap(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::bitSwap(value);
+
     if constexpr (sizeof(Integral) == 1)
     {
         value = shr(value & 0xF0, 4) | (value & 0x0F) << 4;
@@ -309,11 +397,120 @@ Integral bitSwap(Integral value)
     return value;
 }
 
+enum class Endian
+{
+    Little,
+    Big,
+    Native = SHELL_ENDIAN_LITTLE ? Little : Big
+};
+
+template<typename Integral, Endian kEndian = Endian::Native>
+Integral load(const void* data)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    Integral value;
+    std::memcpy(&value, data, sizeof(Integral));
+
+    if constexpr (kEndian != Endian::Native)
+        value = byteSwap(value);
+
+    return value;
+}
+
+template<typename Integral, Endian kEndian = Endian::Native>
+void store(void* data, Integral value)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    if constexpr (kEndian != Endian::Native)
+        value = byteSwap(value);
+
+    std::memcpy(data, &value, sizeof(Integral));
+}
+
+namespace detail
+{
+
+#if SHELL_ARCH_X64 && !SHELL_CC_EMSCRIPTEN
+
+inline bool hasAvx2()
+{
+    #if SHELL_CC_MSVC
+    static const bool kAvx2 = []()
+    {
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    #else
+    static const bool kAvx2 = __builtin_cpu_supports("avx2");
+    #endif
+    return kAvx2;
+}
+
+template<typename Integral>
+SHELL_TARGET("avx2") std::size_t byteSwapAvx2(Integral* data, std::size_t size)
+{
+    constexpr std::size_t kStep = sizeof(__m256i) / sizeof(Integral);
+
+    alignas(16) u8 indices[16];
+    for (uint i = 0; i < 16; ++i)
+        indices[i] = static_cast<u8>(i - i % sizeof(Integral) + sizeof(Integral) - 1 - i % sizeof(Integral));
+
+    const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(indices)));
+
+    std::size_t i = 0;
+    for (; i + kStep <= size; i += kStep)
+    {
+        __m256i* address = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), shuffle));
+    }
+    return i;
+}
+
+#endif
+
+}  // namespace detail
+
+template<typename Integral>
+void byteSwapRange(Integral* data, std::size_t size)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    std::size_t i = 0;
+    if constexpr (sizeof(Integral) > 1)
+    {
+        #if SHELL_ARCH_X64 && !SHELL_CC_EMSCRIPTEN
+        #  ifndef __AVX2__
+        if (detail::hasAvx2())
+        #  endif
+            i = detail::byteSwapAvx2(data, size);
+        #endif
+
+        for (; i < size; ++i)
+            data[i] = byteSwap(data[i]);
+    }
+}
+
+template<typename Range>
+void byteSwapRange(Range& range)
+{
+    byteSwapRange(std::data(range), std::size(range));
+}
+
 template<typename Integral>
-uint popcnt(Integral value)
+constexpr uint popcnt(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::popcnt(value);
+
     #if SHELL_CC_MSVC
     if constexpr (sizeof(Integral) <= 2) return __popcnt16(value);
     if constexpr (sizeof(Integral) == 4) return __popcnt  (value);
@@ -325,11 +522,14 @@ uint popcnt(Integral value)
 }
 
 template<typename Integral>
-uint clz(Integral value)
+constexpr uint clz(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
     SHELL_ASSERT(value != 0);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::clz(value);
+
     #if SHELL_CC_MSVC
     unsigned long index;
     if constexpr (sizeof(Integral) <= 4) _BitScanReverse  (&index, value);
@@ -344,7 +544,7 @@ uint clz(Integral value)
 }
 
 template<typename Integral>
-uint clzSafe(Integral value)
+constexpr uint clzSafe(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
 
@@ -355,11 +555,14 @@ uint clzSafe(Integral value)
 }
 
 template<typename Integral>
-uint ctz(Integral value)
+constexpr uint ctz(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
     SHELL_ASSERT(value != 0);
 
+    if (SHELL_CONSTANT_EVALUATED())
+        return detail::ctz(value);
+
     #if SHELL_CC_MSVC
     unsigned long index;
     if constexpr (sizeof(Integral) <= 4) _BitScanForward  (&index, value);
@@ -372,7 +575,7 @@ uint ctz(Integral value)
 }
 
 template<typename Integral>
-uint ctzSafe(Integral value)
+constexpr uint ctzSafe(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
 
@@ -383,7 +586,15 @@ uint ctzSafe(Integral value)
 }
 
 template<typename Integral>
-Integral ceilPowTwo(Integral value)
+constexpr bool isPowTwo(Integral value)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+template<typename Integral>
+constexpr Integral ceilPowTwo(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
     static_assert(std::is_unsigned_v<Integral>);
@@ -393,7 +604,7 @@ Integral ceilPowTwo(Integral value)
 }
 
 template<typename Integral>
-Integral ceilPowTwoSafe(Integral value)
+constexpr Integral ceilPowTwoSafe(Integral value)
 {
     static_assert(std::is_integral_v<Integral>);
     static_assert(std::is_unsigned_v<Integral>);
@@ -404,6 +615,206 @@ Integral ceilPowTwoSafe(Integral value)
         return 1;
 }
 
+namespace detail
+{
+
+template<typename Integral>
+constexpr Integral extract(Integral value, Integral mask)
+{
+    Integral result = 0;
+    for (Integral bit = 1; mask; bit <<= 1)
+    {
+        if (value & mask & twos(mask))
+            result |= bit;
+
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+template<typename Integral>
+constexpr Integral deposit(Integral value, Integral mask)
+{
+    Integral result = 0;
+    for (Integral bit = 1; mask; bit <<= 1)
+    {
+        if (value & bit)
+            result |= mask & twos(mask);
+
+        mask &= mask - 1;
+    }
+    return result;
+}
+
+#if SHELL_ARCH_X64 && !SHELL_CC_EMSCRIPTEN
+
+inline bool hasBmi2()
+{
+    #if SHELL_CC_MSVC
+    static const bool kBmi2 = []()
+    {
+        int info[4];
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 8)) != 0;
+    }();
+    #else
+    static const bool kBmi2 = __builtin_cpu_supports("bmi2");
+    #endif
+    return kBmi2;
+}
+
+SHELL_TARGET("bmi2") inline u32 pext(u32 value, u32 mask) { return _pext_u32(value, mask); }
+SHELL_TARGET("bmi2") inline u64 pext(u64 value, u64 mask) { return _pext_u64(value, mask); }
+SHELL_TARGET("bmi2") inline u32 pdep(u32 value, u32 mask) { return _pdep_u32(value, mask); }
+SHELL_TARGET("bmi2") inline u64 pdep(u64 value, u64 mask) { return _pdep_u64(value, mask); }
+
+#endif
+
+}  // namespace detail
+
+template<typename Integral>
+Integral extract(Integral value, Integral mask)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    using Unsigned = std::conditional_t<sizeof(Integral) <= 4, u32, u64>;
+
+    #if SHELL_ARCH_X64 && !SHELL_CC_EMSCRIPTEN
+    #  ifndef __BMI2__
+    if (detail::hasBmi2())
+    #  endif
+        return static_cast<Integral>(detail::pext(
+            static_cast<Unsigned>(static_cast<std::make_unsigned_t<Integral>>(value)),
+            static_cast<Unsigned>(static_cast<std::make_unsigned_t<Integral>>(mask))));
+    #endif
+
+    return static_cast<Integral>(detail::extract<std::make_unsigned_t<Integral>>(value, mask));
+}
+
+template<typename Integral>
+Integral deposit(Integral value, Integral mask)
+{
+    static_assert(std::is_integral_v<Integral>);
+
+    using Unsigned = std::conditional_t<sizeof(Integral) <= 4, u32, u64>;
+
+    #if SHELL_ARCH_X64 && !SHELL_CC_EMSCRIPTEN
+    #  ifndef __BMI2__
+    if (detail::hasBmi2())
+    #  endif
+        return static_cast<Integral>(detail::pdep(
+            static_cast<Unsigned>(static_cast<std::make_unsigned_t<Integral>>(value)),
+            static_cast<Unsigned>(static_cast<std::make_unsigned_t<Integral>>(mask))));
+    #endif
+
+    return static_cast<Integral>(detail::deposit<std::make_unsigned_t<Integral>>(value, mask));
+}
+
+template<uint kIndex, uint kSize>
+struct Field
+{
+    static constexpr uint index = kIndex;
+    static constexpr uint size  = kSize;
+};
+
+template<typename Integral, typename... Fields>
+class Layout
+{
+public:
+    static_assert(std::is_integral_v<Integral>);
+    static_assert(sizeof...(Fields) > 0);
+
+    using Values = std::array<Integral, sizeof...(Fields)>;
+
+    static constexpr Integral kMask = (mask<Fields::index, Fields::size, Integral>() | ...);
+
+    static Values unpack(Integral value)
+    {
+        Integral packed = extract(value, kMask);
+
+        Values values{};
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = seq(packed, kOffsets[i], kSizes[i]);
+
+        return values;
+    }
+
+    template<typename Struct>
+    static Struct unpack(Integral value)
+    {
+        return unpack<Struct>(unpack(value), std::make_index_sequence<sizeof...(Fields)>{});
+    }
+
+    static Integral pack(const Values& values)
+    {
+        Integral packed = 0;
+        for (std::size_t i = 0; i < values.size(); ++i)
+            packed |= (values[i] & ones<Integral>(kSizes[i])) << kOffsets[i];
+
+        return deposit(packed, kMask);
+    }
+
+    template<typename... Args>
+    static Integral pack(Args... values)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields));
+
+        return pack(Values{ static_cast<Integral>(values)... });
+    }
+
+private:
+    static constexpr std::array<uint, sizeof...(Fields)> kIndices = { Fields::index... };
+    static constexpr std::array<uint, sizeof...(Fields)> kSizes   = { Fields::size...  };
+
+    static constexpr std::array<uint, sizeof...(Fields)> offsets()
+    {
+        std::array<uint, sizeof...(Fields)> offsets{};
+        for (std::size_t i = 0; i < offsets.size(); ++i)
+        {
+            for (std::size_t j = 0; j < offsets.size(); ++j)
+            {
+                if (kIndices[j] < kIndices[i])
+                    offsets[i] += kSizes[j];
+            }
+        }
+        return offsets;
+    }
+
+    static constexpr bool disjoint()
+    {
+        Integral seen = 0;
+        for (std::size_t i = 0; i < kIndices.size(); ++i)
+        {
+            Integral field = mask<Integral>(kIndices[i], kSizes[i]);
+            if (seen & field)
+                return false;
+
+            seen |= field;
+        }
+        return true;
+    }
+
+    static_assert(disjoint(), "Fields must not overlap");
+
+    static constexpr std::array<uint, sizeof...(Fields)> kOffsets = offsets();
+
+    template<typename Struct, std::size_t... kIndex>
+    static Struct unpack(const Values& values, std::index_sequence<kIndex...>)
+    {
+        return Struct{ values[kIndex]... };
+    }
+};
+
+template<std::size_t kSize, typename Function>
+constexpr auto makeTable(Function func)
+{
+    std::array<decltype(func(std::size_t{})), kSize> table{};
+    for (std::size_t i = 0; i < kSize; ++i)
+        table[i] = func(i);
+
+    return table;
+}
+
 template<typename Integral>
 class BitIterator
 {
@@ -0,0 +1,581 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <shell/bit.h>
+#include <shell/int.h>
+#include <shell/macros.h>
+#include <shell/ranges.h>
+
+namespace shell::bit
+{
+
+namespace detail
+{
+
+enum class BitOp { And, Or, Xor, AndNot };
+
+inline constexpr std::size_t kWordBits = bits_v<u64>;
+
+constexpr std::size_t words(std::size_t size)
+{
+    return (size + kWordBits - 1) / kWordBits;
+}
+
+constexpr u64 tail(std::size_t size)
+{
+    return size % kWordBits ? ones<u64>(size % kWordBits) : ~0ULL;
+}
+
+template<BitOp kOp>
+SHELL_INLINE u64 apply(u64 a, u64 b)
+{
+    if constexpr (kOp == BitOp::And)    return a &  b;
+    if constexpr (kOp == BitOp::Or)     return a |  b;
+    if constexpr (kOp == BitOp::Xor)    return a ^  b;
+    if constexpr (kOp == BitOp::AndNot) return a & ~b;
+}
+
+template<BitOp kOp>
+void apply(u64* dst, const u64* src, std::size_t size)
+{
+    std::size_t i = 0;
+
+    #if defined(__AVX512F__)
+    for (; i + 8 <= size; i += 8)
+    {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+
+        if constexpr (kOp == BitOp::And)    a = _mm512_and_si512(a, b);
+        if constexpr (kOp == BitOp::Or)     a = _mm512_or_si512(a, b);
+        if constexpr (kOp == BitOp::Xor)    a = _mm512_xor_si512(a, b);
+        if constexpr (kOp == BitOp::AndNot) a = _mm512_andnot_si512(b, a);
+
+        _mm512_storeu_si512(dst + i, a);
+    }
+    #elif defined(__AVX2__)
+    for (; i + 4 <= size; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+        if constexpr (kOp == BitOp::And)    a = _mm256_and_si256(a, b);
+        if constexpr (kOp == BitOp::Or)     a = _mm256_or_si256(a, b);
+        if constexpr (kOp == BitOp::Xor)    a = _mm256_xor_si256(a, b);
+        if constexpr (kOp == BitOp::AndNot) a = _mm256_andnot_si256(b, a);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), a);
+    }
+    #endif
+
+    for (; i < size; ++i)
+        dst[i] = apply<kOp>(dst[i], src[i]);
+}
+
+inline std::size_t count(const u64* words, std::size_t size)
+{
+    std::size_t i = 0;
+    std::size_t c0 = 0;
+    std::size_t c1 = 0;
+    std::size_t c2 = 0;
+    std::size_t c3 = 0;
+
+    #if defined(__AVX512VPOPCNTDQ__)
+    __m512i sum = _mm512_setzero_si512();
+    for (; i + 8 <= size; i += 8)
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+
+    c0 = _mm512_reduce_add_epi64(sum);
+    #endif
+
+    for (; i + 4 <= size; i += 4)
+    {
+        c0 += popcnt(words[i + 0]);
+        c1 += popcnt(words[i + 1]);
+        c2 += popcnt(words[i + 2]);
+        c3 += popcnt(words[i + 3]);
+    }
+
+    switch (size - i)
+    {
+    case 3: c2 += popcnt(words[i + 2]); [[fallthrough]];
+    case 2: c1 += popcnt(words[i + 1]); [[fallthrough]];
+    case 1: c0 += popcnt(words[i + 0]); break;
+    }
+
+    return c0 + c1 + c2 + c3;
+}
+
+inline std::size_t find(const u64* words, std::size_t size, std::size_t index)
+{
+    std::size_t word = index / kWordBits;
+    if (word >= size)
+        return size * kWordBits;
+
+    u64 value = words[word] & (~0ULL << (index % kWordBits));
+
+    while (value == 0)
+    {
+        if (++word == size)
+            return size * kWordBits;
+
+        value = words[word];
+    }
+    return word * kWordBits + ctz(value);
+}
+
+}  // namespace detail
+
+class BitSetIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = std::size_t;
+    using reference         = value_type&;
+    using pointer           = value_type*;
+
+    BitSetIterator(const u64* words, std::size_t size)
+        : _words(words), _size(size), _bits(0)
+    {
+        next();
+    }
+
+    std::size_t operator*() const
+    {
+        return _index * detail::kWordBits + *_bits;
+    }
+
+    BitSetIterator& operator++()
+    {
+        if (++_bits == Sentinel{})
+            next();
+
+        return *this;
+    }
+
+    bool operator==(Sentinel) const
+    {
+        return _index == _size;
+    }
+
+    bool operator!=(Sentinel) const
+    {
+        return !(*this == Sentinel{});
+    }
+
+private:
+    void next()
+    {
+        while (++_index < _size)
+        {
+            if (_words[_index])
+            {
+                _bits = BitIterator<u64>(_words[_index]);
+                break;
+            }
+        }
+    }
+
+    const u64* _words;
+    std::size_t _size;
+    std::size_t _index = -1;
+    BitIterator<u64> _bits;
+};
+
+template<std::size_t kSize>
+class BitSet
+{
+public:
+    static_assert(kSize > 0);
+
+    using iterator       = BitSetIterator;
+    using const_iterator = iterator;
+    using sentinel       = Sentinel;
+    using const_sentinel = const sentinel;
+
+    static constexpr std::size_t size()
+    {
+        return kSize;
+    }
+
+    bool operator[](std::size_t index) const
+    {
+        return test(index);
+    }
+
+    bool test(std::size_t index) const
+    {
+        SHELL_ASSERT(index < kSize);
+        return (_words[index / detail::kWordBits] >> (index % detail::kWordBits)) & 0x1;
+    }
+
+    void set(std::size_t index)
+    {
+        SHELL_ASSERT(index < kSize);
+        _words[index / detail::kWordBits] |= 1ULL << (index % detail::kWordBits);
+    }
+
+    void set(std::size_t index, bool value)
+    {
+        if (value)
+            set(index);
+        else
+            reset(index);
+    }
+
+    void set()
+    {
+        _words.fill(~0ULL);
+        _words.back() &= detail::tail(kSize);
+    }
+
+    void reset(std::size_t index)
+    {
+        SHELL_ASSERT(index < kSize);
+        _words[index / detail::kWordBits] &= ~(1ULL << (index % detail::kWordBits));
+    }
+
+    void reset()
+    {
+        _words.fill(0);
+    }
+
+    void flip(std::size_t index)
+    {
+        SHELL_ASSERT(index < kSize);
+        _words[index / detail::kWordBits] ^= 1ULL << (index % detail::kWordBits);
+    }
+
+    void flip()
+    {
+        for (auto& word : _words)
+            word = ~word;
+
+        _words.back() &= detail::tail(kSize);
+    }
+
+    std::size_t count() const
+    {
+        return detail::count(_words.data(), kWords);
+    }
+
+    bool any() const
+    {
+        return findFirst() != kSize;
+    }
+
+    bool none() const
+    {
+        return !any();
+    }
+
+    bool all() const
+    {
+        return count() == kSize;
+    }
+
+    std::size_t findFirst() const
+    {
+        return std::min(detail::find(_words.data(), kWords, 0), kSize);
+    }
+
+    std::size_t findNext(std::size_t index) const
+    {
+        return index + 1 < kSize
+            ? std::min(detail::find(_words.data(), kWords, index + 1), kSize)
+            : kSize;
+    }
+
+    BitSet& operator&=(const BitSet& other)
+    {
+        detail::apply<detail::BitOp::And>(_words.data(), other._words.data(), kWords);
+        return *this;
+    }
+
+    BitSet& operator|=(const BitSet& other)
+    {
+        detail::apply<detail::BitOp::Or>(_words.data(), other._words.data(), kWords);
+        return *this;
+    }
+
+    BitSet& operator^=(const BitSet& other)
+    {
+        detail::apply<detail::BitOp::Xor>(_words.data(), other._words.data(), kWords);
+        return *this;
+    }
+
+    BitSet& andNot(const BitSet& other)
+    {
+        detail::apply<detail::BitOp::AndNot>(_words.data(), other._words.data(), kWords);
+        return *this;
+    }
+
+    BitSet operator&(const BitSet& other) const
+    {
+        return BitSet(*this) &= other;
+    }
+
+    BitSet operator|(const BitSet& other) const
+    {
+        return BitSet(*this) |= other;
+    }
+
+    BitSet operator^(const BitSet& other) const
+    {
+        return BitSet(*this) ^= other;
+    }
+
+    BitSet operator~() const
+    {
+        BitSet result(*this);
+        result.flip();
+        return result;
+    }
+
+    bool operator==(const BitSet& other) const
+    {
+        return _words == other._words;
+    }
+
+    bool operator!=(const BitSet& other) const
+    {
+        return !(*this == other);
+    }
+
+    u64* data()
+    {
+        return _words.data();
+    }
+
+    const u64* data() const
+    {
+        return _words.data();
+    }
+
+    static constexpr std::size_t words()
+    {
+        return kWords;
+    }
+
+    iterator begin() const { return iterator(_words.data(), kWords); }
+    sentinel end()   const { return sentinel(); }
+
+private:
+    static constexpr std::size_t kWords = detail::words(kSize);
+
+    std::array<u64, kWords> _words = {};
+};
+
+class DynamicBitSet
+{
+public:
+    using iterator       = BitSetIterator;
+    using const_iterator = iterator;
+    using sentinel       = Sentinel;
+    using const_sentinel = const sentinel;
+
+    DynamicBitSet() = default;
+
+    explicit DynamicBitSet(std::size_t size, bool value = false)
+    {
+        resize(size, value);
+    }
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    void resize(std::size_t size, bool value = false)
+    {
+        if (value && _size % detail::kWordBits)
+            _words.back() |= ~detail::tail(_size);
+
+        _words.resize(detail::words(size), value ? ~0ULL : 0);
+        _size = size;
+
+        trim();
+    }
+
+    bool operator[](std::size_t index) const
+    {
+        return test(index);
+    }
+
+    bool test(std::size_t index) const
+    {
+        SHELL_ASSERT(index < _size);
+        return (_words[index / detail::kWordBits] >> (index % detail::kWordBits)) & 0x1;
+    }
+
+    void set(std::size_t index)
+    {
+        SHELL_ASSERT(index < _size);
+        _words[index / detail::kWordBits] |= 1ULL << (index % detail::kWordBits);
+    }
+
+    void set(std::size_t index, bool value)
+    {
+        if (value)
+            set(index);
+        else
+            reset(index);
+    }
+
+    void set()
+    {
+        std::fill(_words.begin(), _words.end(), ~0ULL);
+        trim();
+    }
+
+    void reset(std::size_t index)
+    {
+        SHELL_ASSERT(index < _size);
+        _words[index / detail::kWordBits] &= ~(1ULL << (index % detail::kWordBits));
+    }
+
+    void reset()
+    {
+        std::fill(_words.begin(), _words.end(), 0);
+    }
+
+    void flip(std::size_t index)
+    {
+        SHELL_ASSERT(index < _size);
+        _words[index / detail::kWordBits] ^= 1ULL << (index % detail::kWordBits);
+    }
+
+    void flip()
+    {
+        for (auto& word : _words)
+            word = ~word;
+
+        trim();
+    }
+
+    std::size_t count() const
+    {
+        return detail::count(_words.data(), _words.size());
+    }
+
+    bool any() const
+    {
+        return findFirst() != _size;
+    }
+
+    bool none() const
+    {
+        return !any();
+    }
+
+    bool all() const
+    {
+        return count() == _size;
+    }
+
+    std::size_t findFirst() const
+    {
+        return std::min(detail::find(_words.data(), _words.size(), 0), _size);
+    }
+
+    std::size_t findNext(std::size_t index) const
+    {
+        return index + 1 < _size
+            ? std::min(detail::find(_words.data(), _words.size(), index + 1), _size)
+            : _size;
+    }
+
+    DynamicBitSet& operator&=(const DynamicBitSet& other)
+    {
+        SHELL_ASSERT(_size == other._size);
+        detail::apply<detail::BitOp::And>(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    DynamicBitSet& operator|=(const DynamicBitSet& other)
+    {
+        SHELL_ASSERT(_size == other._size);
+        detail::apply<detail::BitOp::Or>(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    DynamicBitSet& operator^=(const DynamicBitSet& other)
+    {
+        SHELL_ASSERT(_size == other._size);
+        detail::apply<detail::BitOp::Xor>(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    DynamicBitSet& andNot(const DynamicBitSet& other)
+    {
+        SHELL_ASSERT(_size == other._size);
+        detail::apply<detail::BitOp::AndNot>(_words.data(), other._words.data(), _words.size());
+        return *this;
+    }
+
+    DynamicBitSet operator&(const DynamicBitSet& other) const
+    {
+        return DynamicBitSet(*this) &= other;
+    }
+
+    DynamicBitSet operator|(const DynamicBitSet& other) const
+    {
+        return DynamicBitSet(*this) |= other;
+    }
+
+    DynamicBitSet operator^(const DynamicBitSet& other) const
+    {
+        return DynamicBitSet(*this) ^= other;
+    }
+
+    DynamicBitSet operator~() const
+    {
+        DynamicBitSet result(*this);
+        result.flip();
+        return result;
+    }
+
+    bool operator==(const DynamicBitSet& other) const
+    {
+        return _size == other._size && _words == other._words;
+    }
+
+    bool operator!=(const DynamicBitSet& other) const
+    {
+        return !(*this == other);
+    }
+
+    u64* data()
+    {
+        return _words.data();
+    }
+
+    const u64* data() const
+    {
+        return _words.data();
+    }
+
+    std::size_t words() const
+    {
+        return _words.size();
+    }
+
+    iterator begin() const { return iterator(_words.data(), _words.size()); }
+    sentinel end()   const { return sentinel(); }
+
+private:
+    void trim()
+    {
+        if (_words.size())
+            _words.back() &= detail::tail(_size);
+    }
+
+    std::vector<u64> _words;
+    std::size_t _size = 0;
+};
+
+}  // namespace shell::bit
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <cstring>
+#include <iterator>
+
+#include <shell/bit.h>
+#include <shell/int.h>
+#include <shell/macros.h>
+
+namespace shell::bit
+{
+
+enum class BitOrder { Lsb, Msb };
+
+template<typename Integral>
+constexpr std::make_unsigned_t<Integral> zigZagEncode(Integral value)
+{
+    static_assert(std::is_signed_v<Integral>);
+
+    using Unsigned = std::make_unsigned_t<Integral>;
+
+    return (static_cast<Unsigned>(value) << 1) ^ static_cast<Unsigned>(value >> (bits_v<Integral> - 1));
+}
+
+template<typename Integral>
+constexpr std::make_signed_t<Integral> zigZagDecode(Integral value)
+{
+    static_assert(std::is_unsigned_v<Integral>);
+
+    return static_cast<std::make_signed_t<Integral>>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+namespace detail
+{
+
+template<BitOrder kOrder>
+u64 loadBits(const u8* data)
+{
+    return load<u64, kOrder == BitOrder::Lsb ? Endian::Little : Endian::Big>(data);
+}
+
+template<BitOrder kOrder>
+void storeBits(u8* data, u64 value)
+{
+    store<u64, kOrder == BitOrder::Lsb ? Endian::Little : Endian::Big>(data, value);
+}
+
+template<typename Container>
+void assertBytes()
+{
+    using Value = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>>;
+
+    static_assert(sizeof(Value) == 1 && std::is_trivially_copyable_v<Value>);
+}
+
+}  // namespace detail
+
+template<BitOrder kOrder = BitOrder::Lsb>
+class BitReader
+{
+public:
+    static constexpr uint kMaxBits = 56;
+
+    BitReader(const void* data, std::size_t size)
+        : _data(static_cast<const u8*>(data)), _size(size) {}
+
+    template<typename Container>
+    explicit BitReader(const Container& container)
+        : BitReader(std::data(container), std::size(container))
+    {
+        detail::assertBytes<const Container>();
+    }
+
+    void refill()
+    {
+        if (_index + sizeof(u64) <= _size)
+        {
+            _buffer |= shift(detail::loadBits<kOrder>(_data + _index));
+            _index  += (63 - _count) >> 3;
+            _count  |= 56;
+        }
+        else
+        {
+            refillTail();
+        }
+    }
+
+    u64 peek(uint size) const
+    {
+        SHELL_ASSERT(size <= kMaxBits);
+        SHELL_ASSERT(size <= _count);
+
+        if constexpr (kOrder == BitOrder::Lsb)
+            return _buffer & ones<u64>(size);
+        else
+            return (_buffer >> 1) >> (63 - size);
+    }
+
+    void consume(uint size)
+    {
+        SHELL_ASSERT(size <= _count);
+
+        if constexpr (kOrder == BitOrder::Lsb)
+            _buffer >>= size;
+        else
+            _buffer <<= size;
+
+        _count -= size;
+    }
+
+    u64 read(uint size)
+    {
+        refill();
+        u64 value = peek(size);
+        consume(size);
+        return value;
+    }
+
+    bool readBit()
+    {
+        return read(1) != 0;
+    }
+
+    template<typename Integral = u64>
+    Integral readVarint()
+    {
+        static_assert(std::is_unsigned_v<Integral>);
+
+        Integral value = 0;
+        for (uint shift = 0; shift < bits_v<Integral>; shift += 7)
+        {
+            u64 byte = read(8);
+            value |= static_cast<Integral>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        return value;
+    }
+
+    template<typename Integral = s64>
+    Integral readSignedVarint()
+    {
+        static_assert(std::is_signed_v<Integral>);
+
+        return zigZagDecode(readVarint<std::make_unsigned_t<Integral>>());
+    }
+
+    void align()
+    {
+        refill();
+        consume(static_cast<uint>((8 - position() % 8) % 8));
+    }
+
+    std::size_t position() const
+    {
+        return CHAR_BIT * _index - _count;
+    }
+
+    std::size_t remaining() const
+    {
+        return position() < CHAR_BIT * _size ? CHAR_BIT * _size - position() : 0;
+    }
+
+    bool overrun() const
+    {
+        return position() > CHAR_BIT * _size;
+    }
+
+private:
+    u64 shift(u64 value) const
+    {
+        if constexpr (kOrder == BitOrder::Lsb)
+            return value << _count;
+        else
+            return value >> _count;
+    }
+
+    void refillTail()
+    {
+        u8 tail[sizeof(u64)] = {};
+        if (_index < _size)
+            std::memcpy(tail, _data + _index, _size - _index);
+
+        _buffer |= shift(detail::loadBits<kOrder>(tail));
+        _index  += (63 - _count) >> 3;
+        _count  |= 56;
+    }
+
+    const u8* _data;
+    std::size_t _size;
+    std::size_t _index = 0;
+    u64 _buffer = 0;
+    uint _count = 0;
+};
+
+template<BitOrder kOrder = BitOrder::Lsb>
+class BitWriter
+{
+public:
+    static constexpr uint kMaxBits = 56;
+
+    BitWriter(void* data, std::size_t size)
+        : _data(static_cast<u8*>(data)), _size(size) {}
+
+    template<typename Container>
+    explicit BitWriter(Container& container)
+        : BitWriter(std::data(container), std::size(container))
+    {
+        detail::assertBytes<Container>();
+    }
+
+    void write(u64 value, uint size)
+    {
+        SHELL_ASSERT(size <= kMaxBits);
+
+        value &= ones<u64>(size);
+
+        if constexpr (kOrder == BitOrder::Lsb)
+            _buffer |= value << _count;
+        else
+            _buffer |= ((value << (63 - size)) << 1) >> _count;
+
+        _count += size;
+        drain();
+    }
+
+    void writeBit(bool value)
+    {
+        write(value, 1);
+    }
+
+    template<typename Integral>
+    void writeVarint(Integral value)
+    {
+        static_assert(std::is_unsigned_v<Integral>);
+
+        while (value >= 0x80)
+        {
+            write((value & 0x7F) | 0x80, 8);
+            value >>= 7;
+        }
+        write(value, 8);
+    }
+
+    template<typename Integral>
+    void writeSignedVarint(Integral value)
+    {
+        static_assert(std::is_signed_v<Integral>);
+
+        writeVarint(zigZagEncode(value));
+    }
+
+    void align()
+    {
+        write(0, (8 - _count % 8) % 8);
+    }
+
+    std::size_t flush()
+    {
+        align();
+        return _index;
+    }
+
+    std::size_t position() const
+    {
+        return CHAR_BIT * _index + _count;
+    }
+
+private:
+    void drain()
+    {
+        uint bytes = _count >> 3;
+        if (_index + sizeof(u64) <= _size)
+        {
+            detail::storeBits<kOrder>(_data + _index, _buffer);
+        }
+        else
+        {
+            SHELL_ASSERT(_index + bytes <= _size);
+
+            u8 tail[sizeof(u64)];
+            detail::storeBits<kOrder>(tail, _buffer);
+            std::memcpy(_data + _index, tail, bytes);
+        }
+
+        _index += bytes;
+        if constexpr (kOrder == BitOrder::Lsb)
+            _buffer >>= CHAR_BIT * bytes;
+        else
+            _buffer <<= CHAR_BIT * bytes;
+
+        _count &= 7;
+    }
+
+    u8* _data;
+    std::size_t _size;
+    std::size_t _index = 0;
+    u64 _buffer = 0;
+    uint _count = 0;
+};
+
+}  // namespace shell::bit
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include <shell/macros.h>
@@ -9,6 +11,35 @@
 namespace shell
 {
 
+namespace detail
+{
+
+template<typename T, std::size_t kSize, bool = std::is_trivial_v<T>>
+struct FixedBufferStorage
+{
+    T data[kSize];
+    std::size_t size = 0;
+};
+
+template<typename T, std::size_t kSize>
+struct FixedBufferStorage<T, kSize, false>
+{
+    FixedBufferStorage() {}
+
+    ~FixedBufferStorage()
+    {
+        std::destroy_n(data, size);
+    }
+
+    union
+    {
+        T data[kSize];
+    };
+    std::size_t size = 0;
+};
+
+}  // namespace detail
+
 template<typename T, std::size_t kSize>
 class FixedBuffer
 {
@@ -17,188 +48,247 @@ class FixedBuffer
 
     using value_type             = T;
     using reference              = value_type&;
-    using const_reference        = const reference;
+    using const_reference        = const value_type&;
     using pointer                = value_type*;
-    using const_pointer          = const pointer;
+    using const_pointer          = const value_type*;
     using iterator               = pointer;
-    using const_iterator         = const iterator;
+    using const_iterator         = const_pointer;
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     FixedBuffer() = default;
 
-    FixedBuffer(const FixedBuffer<T, kSize>& other)
+    constexpr FixedBuffer(const FixedBuffer<T, kSize>& other)
     {
-        copy(other.begin(), other.end());
+        append(other.begin(), other.end());
     }
 
-    FixedBuffer(FixedBuffer<T, kSize>&& other)
+    constexpr FixedBuffer(FixedBuffer<T, kSize>&& other)
     {
-        copy(other.begin(), other.end());
+        append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
     }
 
-    FixedBuffer(std::initializer_list<T> values)
+    constexpr FixedBuffer(std::initializer_list<T> values)
     {
-        copy(values.begin(), values.end());
+        append(values.begin(), values.end());
     }
 
-    FixedBuffer& operator=(const FixedBuffer<T, kSize>& other)
+    constexpr FixedBuffer& operator=(const FixedBuffer<T, kSize>& other)
     {
-        copy(other.begin(), other.end());
+        if (this != &other)
+        {
+            clear();
+            append(other.begin(), other.end());
+        }
         return *this;
     }
 
-    FixedBuffer& operator=(FixedBuffer<T, kSize>&& other)
+    constexpr FixedBuffer& operator=(FixedBuffer<T, kSize>&& other)
     {
-        copy(other.begin(), other.end());
+        if (this != &other)
+        {
+            clear();
+            append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
         return *this;
     }
 
-    reference operator[](std::size_t index)
+    constexpr reference operator[](std::size_t index)
     {
-        SHELL_ASSERT(index < _size);
-        return _stack[index];
+        SHELL_ASSERT(index < size());
+        return _storage.data[index];
     }
 
-    const_reference operator[](std::size_t index) const
+    constexpr const_reference operator[](std::size_t index) const
     {
-        SHELL_ASSERT(index < _size);
-        return _stack[index];
+        SHELL_ASSERT(index < size());
+        return _storage.data[index];
     }
 
-    constexpr std::size_t capacity() const
+    static constexpr std::size_t capacity()
     {
         return kSize;
     }
 
-    std::size_t size() const
+    constexpr std::size_t size() const
     {
-        return _size;
+        return _storage.size;
     }
 
-    pointer data()
+    constexpr bool empty() const
     {
-        return _stack;
+        return _storage.size == 0;
     }
 
-    const_pointer data() const
+    constexpr pointer data()
     {
-        return _stack;
+        return _storage.data;
     }
 
-    void clear()
+    constexpr const_pointer data() const
     {
-        _size = 0;
+        return _storage.data;
     }
 
-    void resize(std::size_t size)
+    constexpr void clear()
+    {
+        destroy(0);
+    }
+
+    constexpr void resize(std::size_t size)
     {
         SHELL_ASSERT(size <= kSize);
-        _size = size;
+
+        if (size < _storage.size)
+        {
+            destroy(size);
+        }
+        else
+        {
+            while (_storage.size < size)
+                emplace_back();
+        }
     }
 
-    void push_back(const T& value)
+    template<typename... Args>
+    constexpr reference emplace_back(Args&&... args)
     {
-        SHELL_ASSERT(_size < kSize);
-        _stack[_size++] = value;
+        SHELL_ASSERT(size() < kSize);
+
+        T* slot = _storage.data + _storage.size;
+
+        if constexpr (std::is_trivial_v<T>)
+            *slot = T(std::forward<Args>(args)...);
+        else
+            new(slot) T(std::forward<Args>(args)...);
+
+        _storage.size++;
+
+        return *slot;
     }
 
-    void push_back(T&& value)
+    constexpr void push_back(const T& value)
     {
-        SHELL_ASSERT(_size < kSize);
-        _stack[_size++] = std::move(value);
+        emplace_back(value);
     }
 
-    void pop_back()
+    constexpr void push_back(T&& value)
     {
-        SHELL_ASSERT(_size > 0);
-        _size--;
+        emplace_back(std::move(value));
     }
 
-    reference front()
+    constexpr void pop_back()
+    {
+        SHELL_ASSERT(size() > 0);
+        destroy(_storage.size - 1);
+    }
+
+    constexpr reference front()
     {
         return (*this)[0];
     }
 
-    const_reference front() const
+    constexpr const_reference front() const
     {
         return (*this)[0];
     }
 
-    reference back()
+    constexpr reference back()
     {
-        return (*this)[_size - 1];
+        return (*this)[size() - 1];
     }
 
-    const_reference back() const
+    constexpr const_reference back() const
     {
-        return (*this)[_size - 1];
+        return (*this)[size() - 1];
     }
 
-    SHELL_FORWARD_ITERATORS(_stack, _stack + _size)
-    SHELL_REVERSE_ITERATORS(_stack + _size, _stack)
+    SHELL_FORWARD_ITERATORS(_storage.data, _storage.data + _storage.size)
+    SHELL_REVERSE_ITERATORS(_storage.data + _storage.size, _storage.data)
 
 private:
     template<typename Iterator>
-    void copy(Iterator begin, Iterator end)
+    constexpr void append(Iterator begin, Iterator end)
     {
-        std::copy(begin, end, this->begin());
+        for (; begin != end; ++begin)
+            emplace_back(*begin);
+    }
+
+    constexpr void destroy(std::size_t size)
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            std::destroy(_storage.data + size, _storage.data + _storage.size);
 
-        _size = std::distance(begin, end);
+        _storage.size = size;
     }
 
-    T _stack[kSize];
-    std::size_t _size = 0;
+    detail::FixedBufferStorage<T, kSize> _storage;
 };
 
-template<typename T, std::size_t kSize>
+template<typename T, std::size_t kSize, typename Allocator = std::allocator<T>>
 class SmallBuffer
 {
 public:
     static_assert(kSize > 0);
 
     using value_type             = T;
+    using allocator_type         = Allocator;
     using reference              = value_type&;
-    using const_reference        = const reference;
+    using const_reference        = const value_type&;
     using pointer                = value_type*;
-    using const_pointer          = const pointer;
+    using const_pointer          = const value_type*;
     using iterator               = pointer;
-    using const_iterator         = const iterator;
+    using const_iterator         = const_pointer;
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     SmallBuffer() = default;
 
-    SmallBuffer(const SmallBuffer<T, kSize>& other)
+    explicit SmallBuffer(const Allocator& allocator)
+        : _allocator(allocator) {}
+
+    SmallBuffer(const SmallBuffer& other)
+        : _allocator(Traits::select_on_container_copy_construction(other._allocator))
     {
         copy(other.begin(), other.end());
     }
 
-    SmallBuffer(SmallBuffer<T, kSize>&& other)
+    SmallBuffer(SmallBuffer&& other)
+        : _allocator(std::move(other._allocator))
     {
         move(std::move(other));
     }
 
-    SmallBuffer(std::initializer_list<T> values)
+    SmallBuffer(std::initializer_list<T> values, const Allocator& allocator = Allocator())
+        : _allocator(allocator)
     {
         copy(values.begin(), values.end());
     }
 
     ~SmallBuffer()
     {
-        if (_data != _stack)
-            delete[] _data;
+        release();
     }
 
-    SmallBuffer& operator=(const SmallBuffer<T, kSize>& other)
+    SmallBuffer& operator=(const SmallBuffer& other)
     {
-        copy(other.begin(), other.end());
+        if (this != &other)
+            copy(other.begin(), other.end());
+
         return *this;
     }
 
-    SmallBuffer& operator=(SmallBuffer<T, kSize>&& other)
+    SmallBuffer& operator=(SmallBuffer&& other)
     {
-        move(std::move(other));
+        if (this != &other)
+        {
+            if constexpr (Traits::propagate_on_container_move_assignment::value)
+            {
+                release();
+                _allocator = std::move(other._allocator);
+            }
+            move(std::move(other));
+        }
         return *this;
     }
 
@@ -214,6 +304,11 @@ class SmallBuffer
         return _data[index];
     }
 
+    allocator_type get_allocator() const
+    {
+        return _allocator;
+    }
+
     std::size_t capacity() const
     {
         return _capacity;
@@ -293,21 +388,57 @@ class SmallBuffer
     SHELL_REVERSE_ITERATORS(_data + _size, _data)
 
 private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    T* allocate(std::size_t capacity)
+    {
+        T* data = Traits::allocate(_allocator, capacity);
+
+        std::size_t i = 0;
+        try
+        {
+            for (; i < capacity; ++i)
+                Traits::construct(_allocator, data + i);
+        }
+        catch (...)
+        {
+            while (i > 0)
+                Traits::destroy(_allocator, data + --i);
+
+            Traits::deallocate(_allocator, data, capacity);
+            throw;
+        }
+        return data;
+    }
+
+    void release()
+    {
+        if (_data == _stack)
+            return;
+
+        for (std::size_t i = 0; i < _capacity; ++i)
+            Traits::destroy(_allocator, _data + i);
+
+        Traits::deallocate(_allocator, _data, _capacity);
+
+        _data = _stack;
+        _capacity = kSize;
+    }
+
     void grow(std::size_t size)
     {
-        std::size_t capacity_old = _capacity;
-        std::size_t capacity_new = std::max(2 * _capacity, size);
+        std::size_t capacity = std::max(2 * _capacity, size);
 
-        T* data_old = _data;
-        T* data_new = new T[capacity_new];
+        T* data = allocate(capacity);
 
-        std::uninitialized_copy(begin(), end(), data_new);
+        std::move(begin(), end(), data);
 
-        _data = data_new;
-        _capacity = capacity_new;
+        std::size_t length = _size;
+        release();
 
-        if (data_old != _stack)
-            delete[] data_old;
+        _data = data;
+        _size = length;
+        _capacity = capacity;
     }
 
     template<typename Iterator>
@@ -318,28 +449,31 @@ class SmallBuffer
         std::copy(begin, end, this->begin());
     }
 
-    void move(SmallBuffer<T, kSize>&& other)
+    void move(SmallBuffer&& other)
     {
-        if (other._data == other._stack)
+        if (other._data == other._stack || _allocator != other._allocator)
         {
-            copy(other.begin(), other.end());
+            copy(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
         }
         else
         {
-            if (_data != _stack)
-                delete[] _data;
+            release();
 
             _data = other._data;
             _size = other._size;
+            _capacity = other._capacity;
 
             other._data = other._stack;
+            other._capacity = kSize;
         }
+        other._size = 0;
     }
 
     T _stack[kSize];
     T* _data = _stack;
     std::size_t _size = 0;
     std::size_t _capacity = kSize;
+    Allocator _allocator;
 };
 
 }  // namespace shell
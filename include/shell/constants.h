@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
+
 namespace shell
 {
 
 inline constexpr auto kLineBreak = "\n";
+inline constexpr std::size_t kCacheLineSize = 64;
 
 }  // namespace shell
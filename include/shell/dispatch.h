@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include <shell/macros.h>
+
+namespace shell
+{
+
+namespace detail
+{
+
+template<typename Handler, typename Function, std::size_t... kIndex>
+constexpr std::array<Function, sizeof...(kIndex)> makeJumpTable(std::index_sequence<kIndex...>)
+{
+    return { &Handler::template handle<kIndex>... };
+}
+
+template<typename Return, std::size_t kIndex, typename Function>
+Return invokeIndex(Function& func)
+{
+    return func(std::integral_constant<std::size_t, kIndex>{});
+}
+
+template<typename Function, std::size_t... kIndex>
+constexpr auto makeIndexTable(std::index_sequence<kIndex...>)
+{
+    using Return = std::invoke_result_t<Function&, std::integral_constant<std::size_t, 0>>;
+
+    return std::array<Return(*)(Function&), sizeof...(kIndex)>{ &invokeIndex<Return, kIndex, Function>... };
+}
+
+}  // namespace detail
+
+template<std::size_t kSize, typename Handler, typename Signature>
+class JumpTable;
+
+template<std::size_t kSize, typename Handler, typename Return, typename... Args>
+class JumpTable<kSize, Handler, Return(Args...)>
+{
+public:
+    using Function = Return(*)(Args...);
+
+    static constexpr std::array<Function, kSize> kTable =
+        detail::makeJumpTable<Handler, Function>(std::make_index_sequence<kSize>{});
+
+    static constexpr std::size_t size()
+    {
+        return kSize;
+    }
+
+    static Return dispatch(std::size_t index, Args... args)
+    {
+        SHELL_ASSERT(index < kSize);
+
+        return kTable[index](std::forward<Args>(args)...);
+    }
+};
+
+template<std::size_t kSize, typename Function>
+decltype(auto) dispatch(std::size_t index, Function&& func)
+{
+    static constexpr auto kTable = detail::makeIndexTable<std::remove_reference_t<Function>>(std::make_index_sequence<kSize>{});
+
+    SHELL_ASSERT(index < kSize);
+
+    return kTable[index](func);
+}
+
+}  // namespace shell
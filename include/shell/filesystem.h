@@ -278,9 +278,9 @@ struct fmt::formatter<shell::filesystem::path>
 };
 
 template<>
-inline std::optional<shell::filesystem::path> shell::parse(const std::string& data)
+inline std::optional<shell::filesystem::path> shell::parse(std::string_view data)
 {
-    auto path = shell::filesystem::u8path(data);
+    auto path = shell::filesystem::u8path(std::string(data));
     path.make_preferred();
 
     if (!shell::filesystem::isValidPath(path))
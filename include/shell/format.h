@@ -1,17 +1,177 @@
 #pragma once
 
+#include <cstdio>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#include <shell/buffer.h>
 #include <shell/fmt.h>
+#include <shell/mp.h>
+
+#define SHELL_FORMAT(format) FMT_COMPILE(format)
+
+namespace fmt
+{
+
+template<typename T, std::size_t kSize, typename Allocator>
+struct is_contiguous<shell::SmallBuffer<T, kSize, Allocator>> : std::true_type {};
+
+}  // namespace fmt
 
 namespace shell
 {
 
+namespace detail
+{
+
+template<typename T>
+inline constexpr bool is_compiled_format_v = fmt::detail::is_compiled_string<std::decay_t<T>>::value;
+
+template<typename T>
+inline constexpr bool is_format_string_v = is_compiled_format_v<T> || fmt::is_compile_string<std::decay_t<T>>::value;
+
+template<typename... Args>
+struct is_styled_compiled_format : std::false_type {};
+
+template<typename Format, typename... Args>
+struct is_styled_compiled_format<fmt::text_style, Format, Args...>
+    : std::bool_constant<is_compiled_format_v<Format>> {};
+
+template<typename... Args>
+inline constexpr bool is_styled_compiled_format_v = is_styled_compiled_format<std::decay_t<Args>...>::value;
+
+template<typename Format>
+std::string_view formatView(const Format& format)
+{
+    if constexpr (is_format_string_v<Format>)
+    {
+        fmt::string_view view = format;
+        return std::string_view(view.data(), view.size());
+    }
+    else
+    {
+        return std::string_view(format);
+    }
+}
+
+template<typename T, typename Function>
+decltype(auto) withThreadLocal(Function func)
+{
+    static thread_local T cache;
+    static thread_local bool busy = false;
+
+    if (busy)
+    {
+        T local;
+        return func(local);
+    }
+
+    struct Release
+    {
+        ~Release()
+        {
+            busy = false;
+        }
+    } release;
+
+    busy = true;
+    return func(cache);
+}
+
+template<typename Format, typename... Args>
+auto formatCompiled(const Format& format, Args&&... args)
+{
+    if constexpr (sizeof...(Args) == 0)
+        return fmt::format(formatView(format));
+    else
+        return fmt::format(format, std::forward<Args>(args)...);
+}
+
+template<typename OutputIterator, typename... Args>
+OutputIterator formatTo(OutputIterator out, Args&&... args)
+{
+    if constexpr (sizeof...(Args) == 1 && !is_format_string_v<mp::first_t<Args...>>)
+        return fmt::format_to(out, "{}", std::forward<Args>(args)...);
+    else if constexpr (sizeof...(Args) == 1)
+        return fmt::format_to(out, formatView(std::forward<Args>(args)...));
+    else
+        return fmt::format_to(out, std::forward<Args>(args)...);
+}
+
+template<typename OutputIterator, typename... Args>
+auto formatToN(OutputIterator out, std::size_t size, Args&&... args)
+{
+    if constexpr (sizeof...(Args) == 1 && !is_format_string_v<mp::first_t<Args...>>)
+        return fmt::format_to_n(out, size, "{}", std::forward<Args>(args)...);
+    else if constexpr (sizeof...(Args) == 1)
+        return fmt::format_to_n(out, size, formatView(std::forward<Args>(args)...));
+    else
+        return fmt::format_to_n(out, size, std::forward<Args>(args)...);
+}
+
+}  // namespace detail
+
+template<typename Buffer, typename... Args>
+std::size_t formatTo(Buffer& buffer, Args&&... args)
+{
+    static_assert(sizeof...(Args) > 0);
+
+    std::size_t size = buffer.size();
+    detail::formatTo(std::back_inserter(buffer), std::forward<Args>(args)...);
+    return buffer.size() - size;
+}
+
+// Truncates at capacity and returns the untruncated size.
+template<std::size_t kSize, typename... Args>
+std::size_t formatTo(FixedBuffer<char, kSize>& buffer, Args&&... args)
+{
+    static_assert(sizeof...(Args) > 0);
+
+    return detail::formatToN(std::back_inserter(buffer), kSize - buffer.size(), std::forward<Args>(args)...).size;
+}
+
+namespace detail
+{
+
+inline void write(std::FILE* file, const fmt::memory_buffer& buffer)
+{
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+}
+
+template<typename... Args>
+void printCompiled(Args&&... args)
+{
+    withThreadLocal<fmt::memory_buffer>([&](fmt::memory_buffer& buffer)
+    {
+        buffer.clear();
+        shell::formatTo(buffer, std::forward<Args>(args)...);
+        write(stdout, buffer);
+    });
+}
+
+template<typename... Args>
+void printStyled(const fmt::text_style& style, Args&&... args)
+{
+    withThreadLocal<fmt::memory_buffer>([&](fmt::memory_buffer& buffer)
+    {
+        buffer.clear();
+        shell::formatTo(buffer, std::forward<Args>(args)...);
+        fmt::print(style, "{}", fmt::string_view(buffer.data(), buffer.size()));
+    });
+}
+
+}  // namespace detail
+
 template<typename... Args>
 auto format(Args&&... args)
 {
     static_assert(sizeof...(Args) > 0);
 
-    if constexpr (sizeof...(Args) == 1)
+    if constexpr (sizeof...(Args) == 1 && !detail::is_format_string_v<mp::first_t<Args...>>)
         return fmt::format("{}", std::forward<Args>(args)...);
+    else if constexpr (detail::is_compiled_format_v<mp::first_t<Args...>>)
+        return detail::formatCompiled(std::forward<Args>(args)...);
     else
         return fmt::format(std::forward<Args>(args)...);
 }
@@ -22,8 +182,12 @@ void print(Args&&... args)
     static_assert(sizeof...(Args) > 0);
 
     #ifndef SHELL_NO_CONSOLE
-    if constexpr (sizeof...(Args) == 1)
+    if constexpr (sizeof...(Args) == 1 && !detail::is_format_string_v<mp::first_t<Args...>>)
         fmt::print("{}", std::forward<Args>(args)...);
+    else if constexpr (detail::is_compiled_format_v<mp::first_t<Args...>>)
+        detail::printCompiled(std::forward<Args>(args)...);
+    else if constexpr (detail::is_styled_compiled_format_v<Args...>)
+        detail::printStyled(std::forward<Args>(args)...);
     else
         fmt::print(std::forward<Args>(args)...);
     #endif
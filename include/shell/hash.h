@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/bit.h>
 #include <shell/int.h>
 
 namespace shell
@@ -10,14 +11,14 @@ inline u64 murmur(const void* key, u64 size, u64 seed)
     constexpr u64 m = 0xC6A4'A793'5BD1'E995;
     constexpr u64 r = 47;
 
-    const u64* data = reinterpret_cast<const u64*>(key);
-    const u64* last = data + size / 8;
+    const u8* data = static_cast<const u8*>(key);
+    const u8* last = data + (size & ~7ULL);
 
     u64 h = seed ^ (size * m);
 
-    while (data != last)
+    for (; data != last; data += 8)
     {
-        u64 k = *data++;
+        u64 k = bit::load<u64, bit::Endian::Little>(data);
 
         k *= m;
         k ^= k >> r;
@@ -27,7 +28,7 @@ inline u64 murmur(const void* key, u64 size, u64 seed)
         h *= m;
     }
 
-    const u8* remaining = reinterpret_cast<const u8*>(data);
+    const u8* remaining = data;
 
     switch (size & 7)
     {
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <shell/algorithm.h>
@@ -20,33 +23,28 @@ namespace detail
 class Parser
 {
 public:
-    Parser(const std::string& data)
-        : _data(data)
-    {
-        value.reserve(data.size());
-    }
+    Parser(std::string_view data)
+        : _data(data) {}
 
     template<typename Predicate>
     std::size_t one(Predicate pred)
     {
-        value.clear();
+        std::size_t begin = index;
         if (index < _data.size() && pred(_data[index]))
-        {
-            value.push_back(_data[index]);
             ++index;
-        }
+
+        value = _data.substr(begin, index - begin);
         return value.size();
     }
 
     template<typename Predicate>
     std::size_t all(Predicate pred)
     {
-        value.clear();
+        std::size_t begin = index;
         while (index < _data.size() && pred(_data[index]))
-        {
-            value.push_back(_data[index]);
             ++index;
-        }
+
+        value = _data.substr(begin, index - begin);
         return value.size();
     }
 
@@ -61,11 +59,11 @@ class Parser
             expected, index, _data, got);
     }
 
-    std::string value;
+    std::string_view value;
     std::size_t index = 0;
 
 private:
-    const std::string& _data;
+    std::string_view _data;
 };
 
 class Token
@@ -76,7 +74,7 @@ class Token
     Token(Kind kind)
         : kind(kind) {}
 
-    virtual void parse(const std::string& line) = 0;
+    virtual void parse(std::string_view line) = 0;
     virtual std::string string() const = 0;
 
     const Kind kind;
@@ -97,10 +95,10 @@ class Token
 class CommentToken final : public Token
 {
 public:
-    CommentToken()
-        : Token(Kind::Comment) {}
+    CommentToken(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Token(Kind::Comment), comment(resource) {}
 
-    void parse(const std::string& line) final
+    void parse(std::string_view line) final
     {
         Parser parser(line);
 
@@ -115,22 +113,22 @@ class CommentToken final : public Token
 
     std::string string() const final
     {
-        return shell::format("# {}", comment);
+        return shell::format("# {}", std::string_view(comment));
     }
 
-    std::string comment;
+    std::pmr::string comment;
 };
 
 class SectionToken final : public Token
 {
 public:
-    SectionToken()
-        : Token(Kind::Section) {}
+    SectionToken(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Token(Kind::Section), section(resource) {}
 
-    SectionToken(const std::string& section)
-        : Token(Kind::Section), section(section) {}
+    SectionToken(std::string_view section, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Token(Kind::Section), section(section, resource) {}
 
-    void parse(const std::string& line) final
+    void parse(std::string_view line) final
     {
         Parser parser(line);
 
@@ -151,22 +149,22 @@ class SectionToken final : public Token
 
     std::string string() const final
     {
-        return shell::format("[{}]", section);
+        return shell::format("[{}]", std::string_view(section));
     }
 
-    std::string section;
+    std::pmr::string section;
 };
 
 class ValueToken final : public Token
 {
 public:
-    ValueToken()
-        : Token(Kind::Value) {}
+    ValueToken(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Token(Kind::Value), key(resource), value(resource) {}
 
-    ValueToken(const std::string& key, const std::string& value)
-        : Token(Kind::Value), key(key), value(value) {}
+    ValueToken(std::string_view key, std::string_view value, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Token(Kind::Value), key(key, resource), value(value, resource) {}
 
-    void parse(const std::string& line) final
+    void parse(std::string_view line) final
     {
         Parser parser(line);
 
@@ -189,13 +187,13 @@ class ValueToken final : public Token
     std::string string() const final
     {
         if (value.empty())
-            return shell::format("{} =", key);
+            return shell::format("{} =", std::string_view(key));
         else
-            return shell::format("{} = {}", key, value);
+            return shell::format("{} = {}", std::string_view(key), std::string_view(value));
     }
 
-    std::string key;
-    std::string value;
+    std::pmr::string key;
+    std::pmr::string value;
 };
 
 }  // namespace detail
@@ -203,11 +201,15 @@ class ValueToken final : public Token
 class Ini
 {
 public:
+    explicit Ini(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : _resource(resource), _tokens(resource) {}
+
     void parse(const std::string& data)
     {
         _tokens.clear();
 
-        for (std::string& line : split(data, kLineBreak))
+        // Lines are views into data, tokens copy their parts into the resource.
+        for (std::string_view line : split(std::string_view(data), kLineBreak, std::pmr::polymorphic_allocator<std::string_view>(_resource)))
         {
             trim(line);
 
@@ -275,23 +277,29 @@ class Ini
     using Token      = std::shared_ptr<detail::Token>;
     using ValueToken = std::shared_ptr<detail::ValueToken>;
 
-    static Token tokenize(const std::string& line)
+    template<typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) const
+    {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(_resource), std::forward<Args>(args)..., _resource);
+    }
+
+    Token tokenize(std::string_view line) const
     {
         if (line.empty())
             return nullptr;
 
         if (line.front() == '#')
-            return std::make_shared<detail::CommentToken>();
+            return make<detail::CommentToken>();
 
         if (line.front() == '[')
-            return std::make_shared<detail::SectionToken>();
+            return make<detail::SectionToken>();
 
-        return std::make_shared<detail::ValueToken>();
+        return make<detail::ValueToken>();
     }
 
-    ValueToken findToken(const std::string& section, const std::string& key) const
+    ValueToken findToken(std::string_view section, std::string_view key) const
     {
-        std::string active;
+        std::string_view active;
 
         for (const auto& token : _tokens)
         {
@@ -311,17 +319,17 @@ class Ini
         return nullptr;
     }
 
-    ValueToken findOrCreateToken(const std::string& section, const std::string& key)
+    ValueToken findOrCreateToken(std::string_view section, std::string_view key)
     {
-        auto insert = [&](std::vector<Token>::const_iterator iter) -> ValueToken
+        auto insert = [&](std::pmr::vector<Token>::const_iterator iter) -> ValueToken
         {
-            ValueToken value = std::make_shared<detail::ValueToken>(key, std::string());
+            ValueToken value = make<detail::ValueToken>(key, std::string_view());
             _tokens.insert(iter, value);
 
             return value;
         };
 
-        std::string active;
+        std::string_view active;
 
         for (auto iter = _tokens.begin(); iter != _tokens.end(); ++iter)
         {
@@ -345,12 +353,13 @@ class Ini
         }
 
         if (active != section)
-            _tokens.push_back(std::make_shared<detail::SectionToken>(section));
+            _tokens.push_back(make<detail::SectionToken>(section));
         
         return insert(_tokens.end());
     }
 
-    std::vector<Token> _tokens;
+    std::pmr::memory_resource* _resource;
+    std::pmr::vector<Token> _tokens;
 };
 
 }  // namespace shell
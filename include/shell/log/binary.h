@@ -0,0 +1,535 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <shell/bit.h>
+#include <shell/bitstream.h>
+#include <shell/filesystem.h>
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/log/rotating.h>
+#include <shell/log/sinks.h>
+
+namespace shell
+{
+
+namespace detail
+{
+
+inline constexpr char kBinaryMagic[] = { 'S', 'H', 'L', 'B' };
+inline constexpr u8 kBinaryVersion = 1;
+
+enum class BinaryRecord : u8 { Site, Message, Text };
+enum class BinaryArg : u8 { Bool, Char, Signed, Unsigned, Float, Double, String };
+
+template<typename T>
+constexpr BinaryArg binaryArg()
+{
+    if constexpr (std::is_same_v<T, bool>)
+        return BinaryArg::Bool;
+    else if constexpr (std::is_same_v<T, char>)
+        return BinaryArg::Char;
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        return BinaryArg::Signed;
+    else if constexpr (std::is_integral_v<T>)
+        return BinaryArg::Unsigned;
+    else if constexpr (std::is_same_v<T, float>)
+        return BinaryArg::Float;
+    else if constexpr (std::is_floating_point_v<T>)
+        return BinaryArg::Double;
+    else
+        return BinaryArg::String;
+}
+
+class BinaryEncoder
+{
+public:
+    explicit BinaryEncoder(std::string& data)
+        : _data(data) {}
+
+    void put(u8 value)
+    {
+        _data.push_back(static_cast<char>(value));
+    }
+
+    template<typename Integral>
+    void putFixed(Integral value)
+    {
+        char bytes[sizeof(Integral)];
+        bit::store<Integral, bit::Endian::Little>(bytes, value);
+        _data.append(bytes, sizeof(Integral));
+    }
+
+    void putVarint(u64 value)
+    {
+        while (value >= 0x80)
+        {
+            put(static_cast<u8>(value | 0x80));
+            value >>= 7;
+        }
+        put(static_cast<u8>(value));
+    }
+
+    void putString(std::string_view value)
+    {
+        putVarint(value.size());
+        _data.append(value.data(), value.size());
+    }
+
+    template<typename T>
+    void putArg(const T& value)
+    {
+        constexpr auto kArg = binaryArg<T>();
+
+        if constexpr (kArg == BinaryArg::Bool || kArg == BinaryArg::Char)
+            put(static_cast<u8>(value));
+        else if constexpr (kArg == BinaryArg::Signed)
+            putVarint(bit::zigZagEncode(static_cast<s64>(value)));
+        else if constexpr (kArg == BinaryArg::Unsigned)
+            putVarint(static_cast<u64>(value));
+        else if constexpr (kArg == BinaryArg::Float)
+            putFloat<u32>(value);
+        else if constexpr (kArg == BinaryArg::Double)
+            putFloat<u64>(static_cast<double>(value));
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            putString(value);
+        else
+            putString(shell::format("{}", value));
+    }
+
+private:
+    template<typename Integral, typename Float>
+    void putFloat(Float value)
+    {
+        static_assert(sizeof(Integral) == sizeof(Float));
+
+        Integral bits;
+        std::memcpy(&bits, &value, sizeof(Float));
+        putFixed(bits);
+    }
+
+    std::string& _data;
+};
+
+class BinaryDecoder
+{
+public:
+    BinaryDecoder(const u8* data, std::size_t size)
+        : _data(data), _size(size) {}
+
+    u8 get()
+    {
+        return ensure(1) ? _data[_index++] : 0;
+    }
+
+    template<typename Integral>
+    Integral getFixed()
+    {
+        if (!ensure(sizeof(Integral)))
+            return 0;
+
+        Integral value = bit::load<Integral, bit::Endian::Little>(_data + _index);
+        _index += sizeof(Integral);
+        return value;
+    }
+
+    u64 getVarint()
+    {
+        u64 value = 0;
+        for (uint shift = 0; shift < 64; shift += 7)
+        {
+            u8 byte = get();
+            value |= static_cast<u64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        return value;
+    }
+
+    std::string getString()
+    {
+        u64 size = getVarint();
+        if (!ensure(size))
+            return std::string();
+
+        std::string value(reinterpret_cast<const char*>(_data + _index), size);
+        _index += size;
+        return value;
+    }
+
+    void getArg(BinaryArg arg, fmt::dynamic_format_arg_store<fmt::format_context>& store)
+    {
+        switch (arg)
+        {
+        case BinaryArg::Bool:     store.push_back(get() != 0); break;
+        case BinaryArg::Char:     store.push_back(static_cast<char>(get())); break;
+        case BinaryArg::Signed:   store.push_back(bit::zigZagDecode(getVarint())); break;
+        case BinaryArg::Unsigned: store.push_back(getVarint()); break;
+        case BinaryArg::Float:    store.push_back(getFloat<float, u32>()); break;
+        case BinaryArg::Double:   store.push_back(getFloat<double, u64>()); break;
+        case BinaryArg::String:   store.push_back(getString()); break;
+
+        default:
+            _overrun = true;
+            break;
+        }
+    }
+
+    bool done() const
+    {
+        return _index == _size;
+    }
+
+    bool overrun() const
+    {
+        return _overrun;
+    }
+
+private:
+    bool ensure(u64 size)
+    {
+        if (size > _size - _index)
+            _overrun = true;
+
+        return !_overrun;
+    }
+
+    template<typename Float, typename Integral>
+    Float getFloat()
+    {
+        Integral bits = getFixed<Integral>();
+
+        Float value;
+        std::memcpy(&value, &bits, sizeof(Float));
+        return value;
+    }
+
+    const u8* _data;
+    std::size_t _size;
+    std::size_t _index = 0;
+    bool _overrun = false;
+};
+
+inline u64 binaryTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace detail
+
+// Copies share the file. Installed with setSink, it stores the arguments
+// of logging macros without formatting them.
+class BinarySink : public BasicSink
+{
+public:
+    static constexpr std::size_t kBufferSize = 64 * 1024;
+
+    explicit BinarySink(const filesystem::path& file, std::size_t buffer_size = kBufferSize)
+        : _state(std::make_shared<State>(file, buffer_size)) {}
+
+    void sink(const std::string& message, Level level)
+    {
+        sink(message, level, std::string());
+    }
+
+    void sink(const std::string& message, Level level, const std::string& location)
+    {
+        std::lock_guard lock(_state->mutex);
+
+        detail::BinaryEncoder encoder(_state->buffer);
+        encoder.put(static_cast<u8>(detail::BinaryRecord::Text));
+        encoder.put(static_cast<u8>(level));
+        encoder.putFixed(detail::binaryTimestamp());
+        encoder.putString(location);
+        encoder.putString(message);
+
+        _state->commit(level);
+    }
+
+    template<typename Format, typename... Args>
+    void log(const LogSite& site, Level level, const Format& format, const Args&... args)
+    {
+        SHELL_ASSERT(_state, "Moved-from sink");
+
+        std::lock_guard lock(_state->mutex);
+
+        detail::BinaryEncoder encoder(_state->buffer);
+        if (_state->define(site.id))
+        {
+            const u8 kinds[] = { static_cast<u8>(detail::binaryArg<Args>())..., 0 };
+            defineSite(encoder, site, detail::formatView(format), std::string_view(
+                reinterpret_cast<const char*>(kinds), sizeof...(Args)));
+        }
+
+        beginMessage(encoder, site, level);
+        (encoder.putArg(args), ...);
+
+        _state->commit(level);
+    }
+
+    void log(const LogSite& site, Level level, const LogArgs& args)
+    {
+        std::lock_guard lock(_state->mutex);
+
+        detail::BinaryEncoder encoder(_state->buffer);
+        if (_state->define(site.id))
+        {
+            std::string kinds;
+            args.visit([&kinds](auto value)
+            {
+                kinds.push_back(static_cast<char>(detail::binaryArg<decltype(value)>()));
+            });
+            defineSite(encoder, site, args.format(), kinds);
+        }
+
+        beginMessage(encoder, site, level);
+        args.visit([&encoder](auto value) { encoder.putArg(value); });
+
+        _state->commit(level);
+    }
+
+    void flush()
+    {
+        std::lock_guard lock(_state->mutex);
+        _state->flush();
+    }
+
+private:
+    static void defineSite(detail::BinaryEncoder& encoder, const LogSite& site, std::string_view format, std::string_view kinds)
+    {
+        encoder.put(static_cast<u8>(detail::BinaryRecord::Site));
+        encoder.putVarint(site.id);
+        encoder.putString(format);
+        encoder.putString(site.file);
+        encoder.putString(site.function);
+        encoder.putVarint(site.line);
+        encoder.put(static_cast<u8>(kinds.size()));
+        for (char kind : kinds)
+            encoder.put(static_cast<u8>(kind));
+    }
+
+    static void beginMessage(detail::BinaryEncoder& encoder, const LogSite& site, Level level)
+    {
+        encoder.put(static_cast<u8>(detail::BinaryRecord::Message));
+        encoder.putVarint(site.id);
+        encoder.put(static_cast<u8>(level));
+        encoder.putFixed(detail::binaryTimestamp());
+    }
+
+    struct State
+    {
+        State(const filesystem::path& file, std::size_t buffer_size)
+            : capacity(buffer_size)
+        {
+            std::error_code ec;
+            filesystem::create_directories(file.parent_path(), ec);
+
+            stream.open(file, true);
+            buffer.reserve(capacity);
+            buffer.append(detail::kBinaryMagic, sizeof(detail::kBinaryMagic));
+            buffer.push_back(static_cast<char>(detail::kBinaryVersion));
+        }
+
+        ~State()
+        {
+            flush();
+        }
+
+        bool define(u32 id)
+        {
+            if (id >= sites.size())
+                sites.resize(id + 1);
+
+            bool defined = sites[id];
+            sites[id] = true;
+            return !defined;
+        }
+
+        void commit(Level level)
+        {
+            if (buffer.size() >= capacity || level >= Level::Error)
+                flush();
+        }
+
+        void flush()
+        {
+            stream.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+
+        std::size_t capacity;
+        std::string buffer;
+        std::vector<bool> sites;
+        detail::RawFile stream;
+        std::mutex mutex;
+    };
+
+    std::shared_ptr<State> _state;
+};
+
+class BinaryLogReader
+{
+public:
+    struct Record
+    {
+        Level level = Level::Info;
+        std::chrono::system_clock::time_point time;
+        std::string location;
+        std::string message;
+    };
+
+    BinaryLogReader(const void* data, std::size_t size)
+        : _decoder(static_cast<const u8*>(data), size)
+    {
+        for (char magic : detail::kBinaryMagic)
+            _valid &= _decoder.get() == static_cast<u8>(magic);
+
+        _valid &= _decoder.get() == detail::kBinaryVersion;
+        _valid &= !_decoder.overrun();
+    }
+
+    template<typename Container>
+    explicit BinaryLogReader(const Container& container)
+        : BinaryLogReader(std::data(container), std::size(container))
+    {
+        bit::detail::assertBytes<const Container>();
+    }
+
+    bool valid() const
+    {
+        return _valid;
+    }
+
+    bool next(Record& record)
+    {
+        while (_valid && !_decoder.done())
+        {
+            auto kind = static_cast<detail::BinaryRecord>(_decoder.get());
+            switch (kind)
+            {
+            case detail::BinaryRecord::Site:
+                readSite();
+                break;
+
+            case detail::BinaryRecord::Message:
+                readMessage(record);
+                return _valid;
+
+            case detail::BinaryRecord::Text:
+                readText(record);
+                return _valid;
+
+            default:
+                _valid = false;
+                break;
+            }
+        }
+        return false;
+    }
+
+    static std::string render(const Record& record)
+    {
+        if (record.location.empty())
+            return shell::format("{} {}", BasicSink::prefix(record.level), record.message);
+        else
+            return shell::format("{} {}: {}", BasicSink::prefix(record.level), record.location, record.message);
+    }
+
+private:
+    struct Site
+    {
+        std::string format;
+        std::string file;
+        std::string function;
+        uint line;
+        std::vector<detail::BinaryArg> args;
+    };
+
+    void readSite()
+    {
+        u32 id = static_cast<u32>(_decoder.getVarint());
+
+        Site& site = _sites[id];
+        site.format   = _decoder.getString();
+        site.file     = _decoder.getString();
+        site.function = _decoder.getString();
+        site.line     = static_cast<uint>(_decoder.getVarint());
+        site.args.resize(_decoder.get());
+        for (auto& arg : site.args)
+            arg = static_cast<detail::BinaryArg>(_decoder.get());
+
+        _valid &= !_decoder.overrun();
+    }
+
+    void readMessage(Record& record)
+    {
+        auto site = _sites.find(static_cast<u32>(_decoder.getVarint()));
+        if (site == _sites.end())
+        {
+            _valid = false;
+            return;
+        }
+
+        record.level    = readLevel();
+        record.time     = readTime();
+        record.location = site->second.function;
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        for (auto arg : site->second.args)
+            _decoder.getArg(arg, store);
+
+        try
+        {
+            record.message = fmt::vformat(site->second.format, store);
+        }
+        catch (const fmt::format_error&)
+        {
+            record.message = site->second.format;
+        }
+
+        _valid &= !_decoder.overrun();
+    }
+
+    void readText(Record& record)
+    {
+        record.level    = readLevel();
+        record.time     = readTime();
+        record.location = _decoder.getString();
+        record.message  = _decoder.getString();
+
+        _valid &= !_decoder.overrun();
+    }
+
+    Level readLevel()
+    {
+        u8 level = _decoder.get();
+        if (level > static_cast<u8>(Level::Fatal))
+            _valid = false;
+
+        return static_cast<Level>(level);
+    }
+
+    std::chrono::system_clock::time_point readTime()
+    {
+        auto time = std::chrono::nanoseconds(_decoder.getFixed<u64>());
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(time));
+    }
+
+    detail::BinaryDecoder _decoder;
+    std::unordered_map<u32, Site> _sites;
+    bool _valid = true;
+};
+
+}  // namespace shell
+
+#define SHELL_LOG_BINARY(sink, level, ...) (sink).log(SHELL_LOG_SITE(), level, __VA_ARGS__)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/log/limit.h>
 #include <shell/log/none.h>
 #include <shell/log/sinks.h>
 
@@ -7,4 +8,25 @@
 #  undef SHELL_LOG_DEBUG
 #endif
 
+#ifdef SHELL_LOG_DEBUG_EVERY_N
+#  undef SHELL_LOG_DEBUG_EVERY_N
+#endif
+
+#ifdef SHELL_LOG_DEBUG_EVERY_MS
+#  undef SHELL_LOG_DEBUG_EVERY_MS
+#endif
+
+#ifdef SHELL_LOG_DEBUG_RATE
+#  undef SHELL_LOG_DEBUG_RATE
+#endif
+
+#ifdef SHELL_LOG_DEBUG_SAMPLE
+#  undef SHELL_LOG_DEBUG_SAMPLE
+#endif
+
 #define SHELL_LOG_DEBUG(...) SHELL_LOG(shell::Level::Debug, __VA_ARGS__)
+
+#define SHELL_LOG_DEBUG_EVERY_N(n, ...)          SHELL_LOG_EVERY_N(shell::Level::Debug, n, __VA_ARGS__)
+#define SHELL_LOG_DEBUG_EVERY_MS(ms, ...)        SHELL_LOG_EVERY_MS(shell::Level::Debug, ms, __VA_ARGS__)
+#define SHELL_LOG_DEBUG_RATE(rate, burst, ...)   SHELL_LOG_RATE(shell::Level::Debug, rate, burst, __VA_ARGS__)
+#define SHELL_LOG_DEBUG_SAMPLE(probability, ...) SHELL_LOG_SAMPLE(shell::Level::Debug, probability, __VA_ARGS__)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/log/limit.h>
 #include <shell/log/none.h>
 #include <shell/log/sinks.h>
 
@@ -7,4 +8,25 @@
 #  undef SHELL_LOG_ERROR
 #endif
 
+#ifdef SHELL_LOG_ERROR_EVERY_N
+#  undef SHELL_LOG_ERROR_EVERY_N
+#endif
+
+#ifdef SHELL_LOG_ERROR_EVERY_MS
+#  undef SHELL_LOG_ERROR_EVERY_MS
+#endif
+
+#ifdef SHELL_LOG_ERROR_RATE
+#  undef SHELL_LOG_ERROR_RATE
+#endif
+
+#ifdef SHELL_LOG_ERROR_SAMPLE
+#  undef SHELL_LOG_ERROR_SAMPLE
+#endif
+
 #define SHELL_LOG_ERROR(...) SHELL_LOG(shell::Level::Error, __VA_ARGS__)
+
+#define SHELL_LOG_ERROR_EVERY_N(n, ...)          SHELL_LOG_EVERY_N(shell::Level::Error, n, __VA_ARGS__)
+#define SHELL_LOG_ERROR_EVERY_MS(ms, ...)        SHELL_LOG_EVERY_MS(shell::Level::Error, ms, __VA_ARGS__)
+#define SHELL_LOG_ERROR_RATE(rate, burst, ...)   SHELL_LOG_RATE(shell::Level::Error, rate, burst, __VA_ARGS__)
+#define SHELL_LOG_ERROR_SAMPLE(probability, ...) SHELL_LOG_SAMPLE(shell::Level::Error, probability, __VA_ARGS__)
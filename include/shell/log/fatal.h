@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/log/limit.h>
 #include <shell/log/none.h>
 #include <shell/log/sinks.h>
 
@@ -7,4 +8,25 @@
 #  undef SHELL_LOG_FATAL
 #endif
 
+#ifdef SHELL_LOG_FATAL_EVERY_N
+#  undef SHELL_LOG_FATAL_EVERY_N
+#endif
+
+#ifdef SHELL_LOG_FATAL_EVERY_MS
+#  undef SHELL_LOG_FATAL_EVERY_MS
+#endif
+
+#ifdef SHELL_LOG_FATAL_RATE
+#  undef SHELL_LOG_FATAL_RATE
+#endif
+
+#ifdef SHELL_LOG_FATAL_SAMPLE
+#  undef SHELL_LOG_FATAL_SAMPLE
+#endif
+
 #define SHELL_LOG_FATAL(...) SHELL_LOG(shell::Level::Fatal, __VA_ARGS__)
+
+#define SHELL_LOG_FATAL_EVERY_N(n, ...)          SHELL_LOG_EVERY_N(shell::Level::Fatal, n, __VA_ARGS__)
+#define SHELL_LOG_FATAL_EVERY_MS(ms, ...)        SHELL_LOG_EVERY_MS(shell::Level::Fatal, ms, __VA_ARGS__)
+#define SHELL_LOG_FATAL_RATE(rate, burst, ...)   SHELL_LOG_RATE(shell::Level::Fatal, rate, burst, __VA_ARGS__)
+#define SHELL_LOG_FATAL_SAMPLE(probability, ...) SHELL_LOG_SAMPLE(shell::Level::Fatal, probability, __VA_ARGS__)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/log/limit.h>
 #include <shell/log/none.h>
 #include <shell/log/sinks.h>
 
@@ -7,4 +8,25 @@
 #  undef SHELL_LOG_INFO
 #endif
 
+#ifdef SHELL_LOG_INFO_EVERY_N
+#  undef SHELL_LOG_INFO_EVERY_N
+#endif
+
+#ifdef SHELL_LOG_INFO_EVERY_MS
+#  undef SHELL_LOG_INFO_EVERY_MS
+#endif
+
+#ifdef SHELL_LOG_INFO_RATE
+#  undef SHELL_LOG_INFO_RATE
+#endif
+
+#ifdef SHELL_LOG_INFO_SAMPLE
+#  undef SHELL_LOG_INFO_SAMPLE
+#endif
+
 #define SHELL_LOG_INFO(...) SHELL_LOG(shell::Level::Info, __VA_ARGS__)
+
+#define SHELL_LOG_INFO_EVERY_N(n, ...)          SHELL_LOG_EVERY_N(shell::Level::Info, n, __VA_ARGS__)
+#define SHELL_LOG_INFO_EVERY_MS(ms, ...)        SHELL_LOG_EVERY_MS(shell::Level::Info, ms, __VA_ARGS__)
+#define SHELL_LOG_INFO_RATE(rate, burst, ...)   SHELL_LOG_RATE(shell::Level::Info, rate, burst, __VA_ARGS__)
+#define SHELL_LOG_INFO_SAMPLE(probability, ...) SHELL_LOG_SAMPLE(shell::Level::Info, probability, __VA_ARGS__)
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/log/sinks.h>
+#include <shell/macros.h>
+#include <shell/predef.h>
+
+#if SHELL_OS_LINUX
+#  include <time.h>
+#endif
+
+namespace shell
+{
+
+namespace detail
+{
+
+inline s64 coarseNow()
+{
+    #if SHELL_OS_LINUX
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+    return static_cast<s64>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+    #else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+inline u64 random()
+{
+    static std::atomic<u64> seed = 0x9E3779B97F4A7C15ULL;
+    static thread_local u64 state = seed.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) | 1;
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+template<typename... Args>
+void logLimited(Level level, u64 suppressed, std::string_view location, Args&&... args)
+{
+    logWith(level, location, [&](std::string& message)
+    {
+        shell::formatTo(message, std::forward<Args>(args)...);
+        if (suppressed > 0)
+            shell::formatTo(message, SHELL_FORMAT(" ({} suppressed)"), suppressed);
+    });
+}
+
+}  // namespace detail
+
+// Per-thread state of a limiter, suppressed calls only touch this.
+struct LimiterLocal
+{
+    u64 countdown = 0;
+    u64 suppressed = 0;
+};
+
+namespace detail
+{
+
+// Suppressed calls are tallied per thread and folded into the shared count
+// in batches or when the thread passes.
+class Suppressed
+{
+public:
+    static constexpr u64 kBatch = 64;
+
+    std::nullopt_t add(LimiterLocal& local)
+    {
+        if (++local.suppressed == kBatch)
+            _count.fetch_add(std::exchange(local.suppressed, 0), std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    u64 take(LimiterLocal& local)
+    {
+        return _count.exchange(0, std::memory_order_relaxed) + std::exchange(local.suppressed, 0);
+    }
+
+private:
+    std::atomic<u64> _count = 0;
+};
+
+}  // namespace detail
+
+// Passes every n-th call of each thread.
+class EveryN
+{
+public:
+    explicit EveryN(u64 n)
+        : _n(std::max<u64>(n, 1)) {}
+
+    std::optional<u64> pass(LimiterLocal& local) const
+    {
+        if (local.countdown != 0)
+        {
+            local.countdown--;
+            return std::nullopt;
+        }
+
+        local.countdown = _n - 1;
+        return std::exchange(local.suppressed, _n - 1);
+    }
+
+private:
+    u64 _n;
+};
+
+class EveryInterval
+{
+public:
+    explicit EveryInterval(std::chrono::nanoseconds interval)
+        : _interval(interval.count()) {}
+
+    std::optional<u64> pass(LimiterLocal& local)
+    {
+        s64 now  = detail::coarseNow();
+        s64 next = _next.load(std::memory_order_relaxed);
+
+        if (now < next || !_next.compare_exchange_strong(next, now + _interval, std::memory_order_relaxed))
+            return _suppressed.add(local);
+
+        return _suppressed.take(local);
+    }
+
+private:
+    s64 _interval;
+    std::atomic<s64> _next = std::numeric_limits<s64>::min();
+    detail::Suppressed _suppressed;
+};
+
+class TokenBucket
+{
+public:
+    TokenBucket(double rate, u64 burst)
+        : _interval(interval(rate))
+        , _tolerance(tolerance(_interval, burst)) {}
+
+    std::optional<u64> pass(LimiterLocal& local)
+    {
+        s64 now = detail::coarseNow();
+        s64 tat = _tat.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            s64 start = std::max(tat, now);
+            if (start - now > _tolerance)
+                return _suppressed.add(local);
+
+            if (_tat.compare_exchange_weak(tat, start + _interval, std::memory_order_relaxed))
+                return _suppressed.take(local);
+        }
+    }
+
+private:
+    // Leaves room to add both to the current time without overflowing.
+    static constexpr s64 kMax = std::numeric_limits<s64>::max() / 4;
+
+    static s64 interval(double rate)
+    {
+        SHELL_ASSERT(rate > 0);
+
+        double interval = 1e9 / rate;
+        return interval >= 0 && interval < static_cast<double>(kMax)
+            ? static_cast<s64>(interval)
+            : kMax;
+    }
+
+    static s64 tolerance(s64 interval, u64 burst)
+    {
+        u64 tokens = std::max<u64>(burst, 1) - 1;
+        if (interval > 0 && tokens > static_cast<u64>(kMax / interval))
+            return kMax;
+
+        return interval * static_cast<s64>(tokens);
+    }
+
+    s64 _interval;
+    s64 _tolerance;
+    std::atomic<s64> _tat = std::numeric_limits<s64>::min();
+    detail::Suppressed _suppressed;
+};
+
+class Sampler
+{
+public:
+    explicit Sampler(double probability)
+        : _threshold(threshold(probability)) {}
+
+    std::optional<u64> pass(LimiterLocal& local)
+    {
+        if (_threshold != kAlways && detail::random() >= _threshold)
+            return _suppressed.add(local);
+
+        return _suppressed.take(local);
+    }
+
+private:
+    static constexpr u64 kAlways = std::numeric_limits<u64>::max();
+
+    static u64 threshold(double probability)
+    {
+        if (probability >= 1.0)
+            return kAlways;
+        if (probability <= 0.0)
+            return 0;
+
+        return static_cast<u64>(probability * 18446744073709551616.0);
+    }
+
+    u64 _threshold;
+    detail::Suppressed _suppressed;
+};
+
+}  // namespace shell
+
+// The limiter is a static of the call site, so its arguments (n, ms, rate,
+// burst, probability) are evaluated once, on the first call. The level
+// headers define compiled-out variants like SHELL_LOG_INFO_EVERY_N.
+#define SHELL_LOG_LIMITED(limiter, level, ...)                                  \
+    do                                                                          \
+    {                                                                           \
+        static limiter;                                                         \
+        static thread_local shell::LimiterLocal shell_local;                    \
+        if (auto shell_suppressed = shell_limiter.pass(shell_local))            \
+            shell::detail::logLimited(                                          \
+                level, *shell_suppressed, SHELL_FUNCTION, __VA_ARGS__);         \
+    } while (false)
+
+#define SHELL_LOG_EVERY_N(level, n, ...)          SHELL_LOG_LIMITED(shell::EveryN shell_limiter(n), level, __VA_ARGS__)
+#define SHELL_LOG_EVERY_MS(level, ms, ...)        SHELL_LOG_LIMITED(shell::EveryInterval shell_limiter(std::chrono::milliseconds(ms)), level, __VA_ARGS__)
+#define SHELL_LOG_RATE(level, rate, burst, ...)   SHELL_LOG_LIMITED(shell::TokenBucket shell_limiter(rate, burst), level, __VA_ARGS__)
+#define SHELL_LOG_SAMPLE(level, probability, ...) SHELL_LOG_LIMITED(shell::Sampler shell_limiter(probability), level, __VA_ARGS__)
@@ -5,3 +5,28 @@
 #define SHELL_LOG_WARN(...)  static_cast<void>(0)
 #define SHELL_LOG_ERROR(...) static_cast<void>(0)
 #define SHELL_LOG_FATAL(...) static_cast<void>(0)
+
+#define SHELL_LOG_DEBUG_EVERY_N(...)  static_cast<void>(0)
+#define SHELL_LOG_DEBUG_EVERY_MS(...) static_cast<void>(0)
+#define SHELL_LOG_DEBUG_RATE(...)     static_cast<void>(0)
+#define SHELL_LOG_DEBUG_SAMPLE(...)   static_cast<void>(0)
+
+#define SHELL_LOG_INFO_EVERY_N(...)  static_cast<void>(0)
+#define SHELL_LOG_INFO_EVERY_MS(...) static_cast<void>(0)
+#define SHELL_LOG_INFO_RATE(...)     static_cast<void>(0)
+#define SHELL_LOG_INFO_SAMPLE(...)   static_cast<void>(0)
+
+#define SHELL_LOG_WARN_EVERY_N(...)  static_cast<void>(0)
+#define SHELL_LOG_WARN_EVERY_MS(...) static_cast<void>(0)
+#define SHELL_LOG_WARN_RATE(...)     static_cast<void>(0)
+#define SHELL_LOG_WARN_SAMPLE(...)   static_cast<void>(0)
+
+#define SHELL_LOG_ERROR_EVERY_N(...)  static_cast<void>(0)
+#define SHELL_LOG_ERROR_EVERY_MS(...) static_cast<void>(0)
+#define SHELL_LOG_ERROR_RATE(...)     static_cast<void>(0)
+#define SHELL_LOG_ERROR_SAMPLE(...)   static_cast<void>(0)
+
+#define SHELL_LOG_FATAL_EVERY_N(...)  static_cast<void>(0)
+#define SHELL_LOG_FATAL_EVERY_MS(...) static_cast<void>(0)
+#define SHELL_LOG_FATAL_RATE(...)     static_cast<void>(0)
+#define SHELL_LOG_FATAL_SAMPLE(...)   static_cast<void>(0)
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <shell/filesystem.h>
+#include <shell/format.h>
+#include <shell/log/sinks.h>
+#include <shell/predef.h>
+
+#if SHELL_OS_WINDOWS
+#  include <fcntl.h>
+#  include <io.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace shell
+{
+
+class Codec
+{
+public:
+    using Pointer = std::shared_ptr<Codec>;
+
+    virtual ~Codec() = default;
+
+    virtual std::string extension() const = 0;
+    virtual bool compress(const filesystem::path& src, const filesystem::path& dst) = 0;
+};
+
+namespace detail
+{
+
+class RawFile
+{
+public:
+    RawFile() = default;
+    RawFile(const RawFile&) = delete;
+    RawFile& operator=(const RawFile&) = delete;
+
+    ~RawFile()
+    {
+        close();
+    }
+
+    bool open(const filesystem::path& file, bool truncate = false)
+    {
+        close();
+
+        #if SHELL_OS_WINDOWS
+        int flags = _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (truncate ? _O_TRUNC : 0);
+        _fd = _wopen(file.c_str(), flags, _S_IREAD | _S_IWRITE);
+        #else
+        int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+        _fd = ::open(file.c_str(), flags, 0644);
+        #endif
+
+        return _fd >= 0;
+    }
+
+    void close()
+    {
+        if (_fd < 0)
+            return;
+
+        #if SHELL_OS_WINDOWS
+        _close(_fd);
+        #else
+        ::close(_fd);
+        #endif
+
+        _fd = -1;
+    }
+
+    bool write(const char* data, std::size_t size)
+    {
+        while (size > 0 && _fd >= 0)
+        {
+            #if SHELL_OS_WINDOWS
+            int written = _write(_fd, data, static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+            #else
+            ssize_t written = ::write(_fd, data, size);
+            if (written < 0 && errno == EINTR)
+                continue;
+            #endif
+
+            if (written <= 0)
+                return false;
+
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return size == 0;
+    }
+
+private:
+    int _fd = -1;
+};
+
+class Compressor
+{
+public:
+    explicit Compressor(Codec::Pointer codec)
+        : _codec(std::move(codec)), _thread([this]() { work(); }) {}
+
+    ~Compressor()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_one();
+        _thread.join();
+    }
+
+    void push(filesystem::path segment)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _segments.push_back(std::move(segment));
+        }
+        _condition.notify_one();
+    }
+
+private:
+    void work()
+    {
+        while (true)
+        {
+            filesystem::path segment;
+            {
+                std::unique_lock lock(_mutex);
+                _condition.wait(lock, [this]() { return _stop || !_segments.empty(); });
+
+                if (_segments.empty())
+                    return;
+
+                segment = std::move(_segments.front());
+                _segments.pop_front();
+            }
+            compress(segment);
+        }
+    }
+
+    void compress(const filesystem::path& segment)
+    {
+        filesystem::path dst(segment);
+        dst += _codec->extension();
+
+        bool compressed = false;
+        try
+        {
+            compressed = _codec->compress(segment, dst);
+        }
+        catch (...) {}
+
+        std::error_code ec;
+        if (compressed)
+            filesystem::remove(segment, ec);
+        else
+            filesystem::remove(dst, ec);
+    }
+
+    Codec::Pointer _codec;
+    std::deque<filesystem::path> _segments;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stop = false;
+    std::thread _thread;
+};
+
+}  // namespace detail
+
+class RotatingFileSink : public BasicSink
+{
+public:
+    static constexpr std::size_t kBufferSize = 1024 * 1024;
+
+    struct Rotation
+    {
+        std::size_t size = 0;
+        std::chrono::seconds interval{ 0 };
+    };
+
+    RotatingFileSink(const filesystem::path& file, const Rotation& rotation, Codec::Pointer codec = nullptr, std::size_t buffer_size = kBufferSize)
+        : _state(std::make_unique<State>(file, rotation, std::move(codec), buffer_size)) {}
+
+    void sink(const std::string& message, Level level)
+    {
+        _state->write(level, SHELL_FORMAT("{} {}\n"), prefix(level), message);
+    }
+
+    void sink(const std::string& message, Level level, const std::string& location)
+    {
+        _state->write(level, SHELL_FORMAT("{} {}: {}\n"), prefix(level), location, message);
+    }
+
+    void flush()
+    {
+        std::lock_guard lock(_state->mutex);
+        _state->flush();
+    }
+
+    void rotate()
+    {
+        std::lock_guard lock(_state->mutex);
+        _state->rotate();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct State
+    {
+        State(const filesystem::path& file, const Rotation& rotation, Codec::Pointer codec, std::size_t buffer_size)
+            : file(file), rotation(rotation), capacity(buffer_size)
+        {
+            if (codec)
+            {
+                extension = codec->extension();
+                compressor = std::make_unique<detail::Compressor>(std::move(codec));
+            }
+
+            buffer.reserve(capacity);
+            open();
+        }
+
+        ~State()
+        {
+            flush();
+        }
+
+        template<typename Format, typename... Args>
+        void write(Level level, const Format& format, const Args&... args)
+        {
+            std::lock_guard lock(mutex);
+
+            if (rotation.interval.count() > 0 && Clock::now() - opened >= rotation.interval)
+                rotate();
+
+            std::size_t begin = buffer.size();
+            fmt::format_to(std::back_inserter(buffer), format, args...);
+            std::size_t size = buffer.size() - begin;
+
+            if (rotation.size > 0 && written > 0 && written + size > rotation.size)
+            {
+                std::string message = buffer.substr(begin);
+                buffer.resize(begin);
+                rotate();
+                buffer += message;
+            }
+
+            written += size;
+            if (buffer.size() >= capacity || level >= Level::Error)
+                flush();
+        }
+
+        void flush()
+        {
+            stream.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+
+        void open()
+        {
+            std::error_code ec;
+            filesystem::create_directories(file.parent_path(), ec);
+
+            stream.open(file);
+            written = filesystem::file_size(file, ec);
+            if (ec)
+                written = 0;
+
+            opened = Clock::now();
+        }
+
+        void rotate()
+        {
+            flush();
+            stream.close();
+
+            if (written > 0)
+            {
+                std::error_code ec;
+                filesystem::path dst = segment();
+                filesystem::rename(file, dst, ec);
+                if (!ec && compressor)
+                    compressor->push(std::move(dst));
+            }
+            open();
+        }
+
+        filesystem::path segment() const
+        {
+            std::string stamp = fmt::format("{:%Y%m%d-%H%M%S}", fmt::gmtime(std::time(nullptr)));
+
+            filesystem::path base = file.parent_path() / file.stem();
+            for (std::size_t index = 0; ; ++index)
+            {
+                filesystem::path dst(base);
+                dst += index == 0
+                    ? fmt::format(".{}", stamp)
+                    : fmt::format(".{}.{}", stamp, index);
+                dst += file.extension();
+
+                filesystem::path compressed(dst);
+                compressed += extension;
+
+                std::error_code ec;
+                if (!filesystem::exists(dst, ec) && !filesystem::exists(compressed, ec))
+                    return dst;
+            }
+        }
+
+        filesystem::path file;
+        Rotation rotation;
+        std::size_t capacity;
+        std::string extension;
+        std::string buffer;
+        std::size_t written = 0;
+        Clock::time_point opened;
+        detail::RawFile stream;
+        std::mutex mutex;
+        std::unique_ptr<detail::Compressor> compressor;
+    };
+
+    std::unique_ptr<State> _state;
+};
+
+}  // namespace shell
@@ -1,12 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include <shell/filesystem.h>
 #include <shell/format.h>
+#include <shell/int.h>
 #include <shell/macros.h>
+#include <shell/ringbuffer.h>
 #include <shell/windows.h>
 
 namespace shell
@@ -14,6 +26,172 @@ namespace shell
 
 enum class Level { Debug, Info, Warn, Error, Fatal };
 
+namespace detail
+{
+
+inline u32 threadId()
+{
+    static std::atomic<u32> next = 0;
+    static thread_local u32 id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+}  // namespace detail
+
+struct LogRecord
+{
+    using Clock = std::chrono::steady_clock;
+
+    LogRecord() = default;
+
+    LogRecord(Level level, std::string message, std::string location = std::string())
+        : level(level)
+        , time(Clock::now())
+        , thread(detail::threadId())
+        , message(std::move(message))
+        , location(std::move(location)) {}
+
+    void reset(Level level, std::string_view location)
+    {
+        this->level  = level;
+        this->time   = Clock::now();
+        this->thread = detail::threadId();
+        this->message.clear();
+        this->location.assign(location);
+    }
+
+    Level level = Level::Info;
+    Clock::time_point time;
+    u32 thread = 0;
+    std::string message;
+    std::string location;
+};
+
+struct LogSite
+{
+    LogSite(const char* file, uint line, const char* function)
+        : file(file), line(line), function(function), id(nextId()) {}
+
+    const char* file;
+    uint line;
+    const char* function;
+    u32 id;
+
+private:
+    static u32 nextId()
+    {
+        static std::atomic<u32> id = 0;
+        return id.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+class LogArgVisitor
+{
+public:
+    virtual ~LogArgVisitor() = default;
+
+    virtual void arg(bool value) = 0;
+    virtual void arg(char value) = 0;
+    virtual void arg(s64 value) = 0;
+    virtual void arg(u64 value) = 0;
+    virtual void arg(float value) = 0;
+    virtual void arg(double value) = 0;
+    virtual void arg(std::string_view value) = 0;
+};
+
+// Format and arguments of a log call, only valid during the call. Other
+// argument types are visited as their formatted string.
+class LogArgs
+{
+public:
+    virtual ~LogArgs() = default;
+
+    virtual std::string_view format() const = 0;
+    virtual std::size_t size() const = 0;
+    virtual void formatTo(std::string& message) const = 0;
+    virtual void visit(LogArgVisitor& visitor) const = 0;
+
+    template<typename Function>
+    void visit(Function func) const
+    {
+        class Visitor : public LogArgVisitor
+        {
+        public:
+            Visitor(Function& func)
+                : _func(func) {}
+
+            void arg(bool value)             { _func(value); }
+            void arg(char value)             { _func(value); }
+            void arg(s64 value)              { _func(value); }
+            void arg(u64 value)              { _func(value); }
+            void arg(float value)            { _func(value); }
+            void arg(double value)           { _func(value); }
+            void arg(std::string_view value) { _func(value); }
+
+        private:
+            Function& _func;
+        } visitor(func);
+
+        visit(static_cast<LogArgVisitor&>(visitor));
+    }
+};
+
+namespace detail
+{
+
+template<typename T>
+void visitLogArg(LogArgVisitor& visitor, const T& value)
+{
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>)
+        visitor.arg(value);
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        visitor.arg(static_cast<s64>(value));
+    else if constexpr (std::is_integral_v<T>)
+        visitor.arg(static_cast<u64>(value));
+    else if constexpr (std::is_same_v<T, float>)
+        visitor.arg(value);
+    else if constexpr (std::is_floating_point_v<T>)
+        visitor.arg(static_cast<double>(value));
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        visitor.arg(std::string_view(value));
+    else
+        visitor.arg(std::string_view(shell::format("{}", value)));
+}
+
+template<typename Format, typename... Args>
+class LogArgsOf final : public LogArgs
+{
+public:
+    LogArgsOf(const Format& format, const Args&... args)
+        : _format(format), _args(args...) {}
+
+    std::string_view format() const
+    {
+        return formatView(_format);
+    }
+
+    std::size_t size() const
+    {
+        return sizeof...(Args);
+    }
+
+    void formatTo(std::string& message) const
+    {
+        std::apply([&](const Args&... args) { shell::formatTo(message, _format, args...); }, _args);
+    }
+
+    void visit(LogArgVisitor& visitor) const
+    {
+        std::apply([&](const Args&... args) { (visitLogArg(visitor, args), ...); }, _args);
+    }
+
+private:
+    const Format& _format;
+    std::tuple<const Args&...> _args;
+};
+
+}  // namespace detail
+
 class BasicSink
 {
 public:
@@ -24,7 +202,25 @@ class BasicSink
     virtual void sink(const std::string& message, Level level) = 0;
     virtual void sink(const std::string& message, Level level, const std::string& location) = 0;
 
-protected:
+    virtual void sink(const LogRecord& record)
+    {
+        if (record.location.empty())
+            sink(record.message, record.level);
+        else
+            sink(record.message, record.level, record.location);
+    }
+
+    // Receives the raw arguments of logging macros, formats them by default.
+    virtual void log(const LogSite& site, Level level, const LogArgs& args)
+    {
+        detail::withThreadLocal<LogRecord>([&](LogRecord& record)
+        {
+            record.reset(level, site.function);
+            args.formatTo(record.message);
+            sink(record);
+        });
+    }
+
     static std::string_view prefix(Level level)
     {
         switch (level)
@@ -47,12 +243,12 @@ class ConsoleSink : public BasicSink
 public:
     void sink(const std::string& message, Level level)
     {
-        shell::print("{} {}\n", prefix(level), message);
+        shell::print(SHELL_FORMAT("{} {}\n"), prefix(level), message);
     }
 
     void sink(const std::string& message, Level level, const std::string& location)
     {
-        shell::print("{} {}: {}\n", prefix(level), location, message);
+        shell::print(SHELL_FORMAT("{} {}: {}\n"), prefix(level), location, message);
     }
 };
 
@@ -74,12 +270,12 @@ class ColoredConsoleSink : public BasicSink
 
     void sink(const std::string& message, Level level)
     {
-        shell::print(style(level), "{} {}\n", prefix(level), message);
+        shell::print(style(level), SHELL_FORMAT("{} {}\n"), prefix(level), message);
     }
 
     void sink(const std::string& message, Level level, const std::string& location)
     {
-        shell::print(style(level), "{} {}: {}\n", prefix(level), location, message);
+        shell::print(style(level), SHELL_FORMAT("{} {}: {}\n"), prefix(level), location, message);
     }
 
 private:
@@ -104,17 +300,29 @@ class FileSink : public BasicSink
 
     void sink(const std::string& message, Level level)
     {
-        if (_stream && _stream.is_open())
-            _stream << shell::format("{} {}\n", prefix(level), message);
+        write(SHELL_FORMAT("{} {}\n"), prefix(level), message);
     }
 
     void sink(const std::string& message, Level level, const std::string& location)
     {
-        if (_stream && _stream.is_open())
-            _stream << shell::format("{} {}: {}\n", prefix(level), location, message);
+        write(SHELL_FORMAT("{} {}: {}\n"), prefix(level), location, message);
     }
 
 private:
+    template<typename... Args>
+    void write(Args&&... args)
+    {
+        if (!_stream || !_stream.is_open())
+            return;
+
+        detail::withThreadLocal<fmt::memory_buffer>([&](fmt::memory_buffer& buffer)
+        {
+            buffer.clear();
+            shell::formatTo(buffer, std::forward<Args>(args)...);
+            _stream.write(buffer.data(), buffer.size());
+        });
+    }
+
     std::ofstream _stream;
 };
 
@@ -124,7 +332,7 @@ class MultiSink : public BasicSink
 public:
     static_assert(sizeof...(Sinks) > 0);
 
-    MultiSink(Sinks&&... sinks)
+    MultiSink(Sinks... sinks)
         : _sinks({ std::make_shared<Sinks>(std::move(sinks))... }) {}
 
     void sink(const std::string& message, Level level)
@@ -139,59 +347,365 @@ class MultiSink : public BasicSink
             sink->sink(message, level, location);
     }
 
+    void sink(const LogRecord& record)
+    {
+        for (auto& sink : _sinks)
+            sink->sink(record);
+    }
+
+    void log(const LogSite& site, Level level, const LogArgs& args)
+    {
+        for (auto& sink : _sinks)
+            sink->log(site, level, args);
+    }
+
 private:
     std::array<BasicSink::Pointer, sizeof...(Sinks)> _sinks;
 };
 
+class AsyncSink : public BasicSink
+{
+public:
+    static constexpr std::size_t kBufferSize = 1024;
+    static constexpr std::chrono::milliseconds kInterval{ 10 };
+
+    template<typename Sink>
+    explicit AsyncSink(Sink&& sink, std::chrono::milliseconds interval = kInterval)
+        : _state(std::make_shared<State>(std::make_shared<std::decay_t<Sink>>(std::forward<Sink>(sink)), interval))
+    {
+        static_assert(std::is_base_of_v<BasicSink, std::decay_t<Sink>>);
+    }
+
+    void sink(const std::string& message, Level level)
+    {
+        _state->push(LogRecord(level, message));
+    }
+
+    void sink(const std::string& message, Level level, const std::string& location)
+    {
+        _state->push(LogRecord(level, message, location));
+    }
+
+    void sink(const LogRecord& record)
+    {
+        _state->push(LogRecord(record));
+    }
+
+    void flush()
+    {
+        _state->drain();
+    }
+
+private:
+    struct Buffer : SpscRingBuffer<LogRecord, kBufferSize>
+    {
+        // Set by the owning thread after its last push.
+        std::atomic<bool> closed = false;
+    };
+
+    struct State : std::enable_shared_from_this<State>
+    {
+        State(BasicSink::Pointer target, std::chrono::milliseconds interval)
+            : target(std::move(target)), interval(interval), thread([this]() { work(); }) {}
+
+        ~State()
+        {
+            {
+                std::lock_guard lock(mutex);
+                stop = true;
+            }
+            condition.notify_one();
+            thread.join();
+            drain();
+        }
+
+        Buffer& local()
+        {
+            struct Local
+            {
+                ~Local()
+                {
+                    if (buffer)
+                        buffer->closed.store(true, std::memory_order_release);
+                }
+
+                std::weak_ptr<State> state;
+                std::shared_ptr<Buffer> buffer;
+            };
+            static thread_local std::unordered_map<const State*, Local> locals;
+
+            auto& entry = locals[this];
+            if (entry.state.expired())
+            {
+                // Another state may have lived at this address, drop the
+                // buffers of all destroyed states.
+                for (auto iter = locals.begin(); iter != locals.end(); )
+                    iter = iter->first != this && iter->second.state.expired() ? locals.erase(iter) : std::next(iter);
+
+                if (entry.buffer)
+                    entry.buffer->closed.store(true, std::memory_order_release);
+
+                entry.state = weak_from_this();
+                entry.buffer = std::make_shared<Buffer>();
+
+                std::lock_guard lock(mutex);
+                buffers.push_back(entry.buffer);
+            }
+            return *entry.buffer;
+        }
+
+        void push(LogRecord&& record)
+        {
+            Level level = record.level;
+
+            Buffer& buffer = local();
+            while (!buffer.try_push(std::move(record)))
+            {
+                condition.notify_one();
+                std::this_thread::yield();
+            }
+
+            if (level >= Level::Error)
+                condition.notify_one();
+        }
+
+        void drain()
+        {
+            std::lock_guard lock(drainer);
+            {
+                std::lock_guard lock(mutex);
+                for (auto iter = buffers.begin(); iter != buffers.end(); )
+                {
+                    auto& buffer = *iter;
+                    bool closed = buffer->closed.load(std::memory_order_acquire);
+                    std::size_t middle = batch.size();
+
+                    LogRecord record;
+                    while (buffer->try_pop(record))
+                        batch.push_back(std::move(record));
+
+                    std::inplace_merge(batch.begin(), batch.begin() + middle, batch.end(),
+                        [](const LogRecord& a, const LogRecord& b) { return a.time < b.time; });
+
+                    // Buffers of exited threads are dropped once drained.
+                    iter = closed ? buffers.erase(iter) : std::next(iter);
+                }
+            }
+
+            for (const auto& record : batch)
+                target->sink(record);
+
+            batch.clear();
+        }
+
+        void work()
+        {
+            std::unique_lock lock(mutex);
+            while (!stop)
+            {
+                condition.wait_for(lock, interval);
+
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+
+        BasicSink::Pointer target;
+        std::chrono::milliseconds interval;
+        std::vector<std::shared_ptr<Buffer>> buffers;
+        std::vector<LogRecord> batch;
+        std::mutex mutex;
+        std::mutex drainer;
+        std::condition_variable condition;
+        bool stop = false;
+        std::thread thread;
+    };
+
+    std::shared_ptr<State> _state;
+};
+
 namespace detail
 {
 
+struct SinkCache;
+
 inline BasicSink::Pointer sink = std::make_shared<ColoredConsoleSink>();
+inline std::atomic<u64> sinkVersion = 0;
+inline std::mutex sinkMutex;
+inline std::vector<std::shared_ptr<SinkCache>> sinkCaches;
+
+// Threads cache the current sink without owning it, exchangeSink waits
+// until no thread uses the previous one before releasing it.
+struct SinkCache
+{
+    BasicSink* sink = nullptr;
+    u64 version = ~0ULL;
+    std::atomic<u32> depth = 0;
+};
+
+inline SinkCache& sinkCache()
+{
+    struct Registration
+    {
+        Registration()
+        {
+            std::lock_guard lock(sinkMutex);
+            sinkCaches.push_back(cache);
+        }
+
+        ~Registration()
+        {
+            std::lock_guard lock(sinkMutex);
+            sinkCaches.erase(std::find(sinkCaches.begin(), sinkCaches.end(), cache));
+        }
+
+        std::shared_ptr<SinkCache> cache = std::make_shared<SinkCache>();
+    };
+    static thread_local Registration registration;
+    return *registration.cache;
+}
+
+template<typename Function>
+void withSink(Function func)
+{
+    auto& cache = sinkCache();
+
+    struct Release
+    {
+        ~Release()
+        {
+            cache.depth.store(depth, std::memory_order_release);
+        }
+
+        SinkCache& cache;
+        u32 depth;
+    } release{ cache, cache.depth.load(std::memory_order_relaxed) };
+
+    cache.depth.store(release.depth + 1, std::memory_order_seq_cst);
+
+    u64 version = sinkVersion.load(std::memory_order_seq_cst);
+    if (cache.version != version)
+    {
+        cache.sink = std::atomic_load(&sink).get();
+        cache.version = version;
+    }
+    func(*cache.sink);
+}
+
+inline void exchangeSink(BasicSink::Pointer pointer)
+{
+    auto& own = sinkCache();
+
+    std::vector<std::shared_ptr<SinkCache>> caches;
+    {
+        std::lock_guard lock(sinkMutex);
+        pointer = std::atomic_exchange(&sink, std::move(pointer));
+        sinkVersion.fetch_add(1, std::memory_order_seq_cst);
+        caches = sinkCaches;
+    }
+
+    // Wait without the lock, threads inside the previous sink may start or
+    // exit other threads. The copies keep caches of exited threads alive.
+    for (const auto& cache : caches)
+    {
+        while (cache.get() != &own && cache->depth.load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+    }
+}
+
+template<typename Function>
+void logWith(Level level, std::string_view location, Function format)
+{
+    withThreadLocal<LogRecord>([&](LogRecord& record)
+    {
+        record.reset(level, location);
+
+        format(record.message);
+        withSink([&](BasicSink& sink) { sink.sink(record); });
+    });
+}
+
+template<typename... Args>
+void log(Level level, std::string_view location, Args&&... args)
+{
+    logWith(level, location, [&](std::string& message)
+    {
+        shell::formatTo(message, std::forward<Args>(args)...);
+    });
+}
+
+template<typename Format, typename... Args>
+void log(const LogSite& site, Level level, const Format& format, const Args&... args)
+{
+    LogArgsOf<Format, Args...> logArgs(format, args...);
+    withSink([&](BasicSink& sink) { sink.log(site, level, logArgs); });
+}
 
 }  // namespace detail
 
-template<typename Sink, typename... Sinks>
+inline BasicSink::Pointer getSink()
+{
+    return std::atomic_load(&detail::sink);
+}
+
+inline void setSink(BasicSink::Pointer sink)
+{
+    SHELL_ASSERT(sink);
+
+    detail::exchangeSink(std::move(sink));
+}
+
+template<typename Sink, typename... Sinks,
+    typename = std::enable_if_t<std::is_base_of_v<BasicSink, std::decay_t<Sink>>>>
 void setSink(Sink&& sink, Sinks&&... sinks)
 {
-    static_assert(std::is_base_of_v<BasicSink, Sink>);
-    static_assert(std::conjunction_v<std::is_base_of<BasicSink, Sinks>...>);
+    static_assert(std::conjunction_v<std::is_base_of<BasicSink, std::decay_t<Sinks>>...>);
 
     if constexpr (sizeof...(Sinks) == 0)
-        detail::sink = std::make_shared<Sink>(std::move(sink));
+        detail::exchangeSink(std::make_shared<std::decay_t<Sink>>(std::forward<Sink>(sink)));
     else 
-        detail::sink = std::make_shared<MultiSink<Sink, Sinks...>>(std::move(sink), std::move(sinks)...);
+        detail::exchangeSink(std::make_shared<MultiSink<std::decay_t<Sink>, std::decay_t<Sinks>...>>(
+            std::forward<Sink>(sink), std::forward<Sinks>(sinks)...));
 }
 
-template<typename... Args>
-void debug(const std::string& format, Args&&... args)
+template<typename Format, typename... Args>
+void debug(const Format& format, Args&&... args)
 {
-    detail::sink->sink(shell::format(format, std::forward<Args>(args)...), Level::Debug);
+    detail::log(Level::Debug, std::string_view(), format, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
-void info(const std::string& format, Args&&... args)
+template<typename Format, typename... Args>
+void info(const Format& format, Args&&... args)
 {
-    detail::sink->sink(shell::format(format, std::forward<Args>(args)...), Level::Info);
+    detail::log(Level::Info, std::string_view(), format, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
-void warn(const std::string& format, Args&&... args)
+template<typename Format, typename... Args>
+void warn(const Format& format, Args&&... args)
 {
-    detail::sink->sink(shell::format(format, std::forward<Args>(args)...), Level::Warn);
+    detail::log(Level::Warn, std::string_view(), format, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
-void error(const std::string& format, Args&&... args)
+template<typename Format, typename... Args>
+void error(const Format& format, Args&&... args)
 {
-    detail::sink->sink(shell::format(format, std::forward<Args>(args)...), Level::Error);
+    detail::log(Level::Error, std::string_view(), format, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
-void fatal(const std::string& format, Args&&... args)
+template<typename Format, typename... Args>
+void fatal(const Format& format, Args&&... args)
 {
-    detail::sink->sink(shell::format(format, std::forward<Args>(args)...), Level::Fatal);
+    detail::log(Level::Fatal, std::string_view(), format, std::forward<Args>(args)...);
 }
 
 }  // namespace shell
 
-#define SHELL_LOG(level, ...) shell::detail::sink->sink(shell::format(__VA_ARGS__), level, SHELL_FUNCTION)
+#define SHELL_LOG_SITE()                                                        \
+    [](const char* function) -> const shell::LogSite&                           \
+    {                                                                           \
+        static const shell::LogSite site(__FILE__, __LINE__, function);         \
+        return site;                                                            \
+    }(SHELL_FUNCTION)
+
+#define SHELL_LOG(level, ...) shell::detail::log(SHELL_LOG_SITE(), level, __VA_ARGS__)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <shell/log/limit.h>
 #include <shell/log/none.h>
 #include <shell/log/sinks.h>
 
@@ -7,4 +8,25 @@
 #  undef SHELL_LOG_WARN
 #endif
 
+#ifdef SHELL_LOG_WARN_EVERY_N
+#  undef SHELL_LOG_WARN_EVERY_N
+#endif
+
+#ifdef SHELL_LOG_WARN_EVERY_MS
+#  undef SHELL_LOG_WARN_EVERY_MS
+#endif
+
+#ifdef SHELL_LOG_WARN_RATE
+#  undef SHELL_LOG_WARN_RATE
+#endif
+
+#ifdef SHELL_LOG_WARN_SAMPLE
+#  undef SHELL_LOG_WARN_SAMPLE
+#endif
+
 #define SHELL_LOG_WARN(...) SHELL_LOG(shell::Level::Warn, __VA_ARGS__)
+
+#define SHELL_LOG_WARN_EVERY_N(n, ...)          SHELL_LOG_EVERY_N(shell::Level::Warn, n, __VA_ARGS__)
+#define SHELL_LOG_WARN_EVERY_MS(ms, ...)        SHELL_LOG_EVERY_MS(shell::Level::Warn, ms, __VA_ARGS__)
+#define SHELL_LOG_WARN_RATE(rate, burst, ...)   SHELL_LOG_RATE(shell::Level::Warn, rate, burst, __VA_ARGS__)
+#define SHELL_LOG_WARN_SAMPLE(probability, ...) SHELL_LOG_SAMPLE(shell::Level::Warn, probability, __VA_ARGS__)
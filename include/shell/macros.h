@@ -8,15 +8,20 @@
 #  define SHELL_INLINE    __forceinline
 #  define SHELL_NO_INLINE __declspec(noinline)
 #  define SHELL_FUNCTION  __FUNCSIG__
+#  define SHELL_TARGET(isa)
 #else
 #  define SHELL_INLINE    inline __attribute__((always_inline))
 #  define SHELL_NO_INLINE __attribute__((noinline))
 #  define SHELL_FUNCTION  __PRETTY_FUNCTION__
+#  define SHELL_TARGET(isa) __attribute__((target(isa)))
 #endif
 
 #define SHELL_ARG(...) __VA_ARGS__
+#define SHELL_CONCAT_IMPL(a, b) a##b
+#define SHELL_CONCAT(a, b) SHELL_CONCAT_IMPL(a, b)
 #define SHELL_UNUSED(variable) static_cast<void>(variable)
 #define SHELL_ASSERT(condition, ...) assert((condition) && #__VA_ARGS__"")
+#define SHELL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 
 #if SHELL_RELEASE
 #  if SHELL_CC_MSVC
@@ -28,6 +33,23 @@
 #  define SHELL_UNREACHABLE SHELL_ASSERT(false, "Unreachable")
 #endif
 
+#if defined(__has_cpp_attribute) && !SHELL_CC_MSVC
+#  if __has_cpp_attribute(clang::musttail)
+#    define SHELL_MUSTTAIL [[clang::musttail]]
+#  elif __has_cpp_attribute(gnu::musttail)
+#    define SHELL_MUSTTAIL [[gnu::musttail]]
+#  endif
+#endif
+
+// Without guaranteed tail calls, handler chains recurse once per handler
+// and overflow the stack in unoptimized builds, loop instead.
+#ifdef SHELL_MUSTTAIL
+#  define SHELL_HAS_MUSTTAIL 1
+#else
+#  define SHELL_HAS_MUSTTAIL 0
+#  define SHELL_MUSTTAIL
+#endif
+
 #define SHELL_INDEX_CASE01(label, index, ...)   \
     case label + index:                         \
     {                                           \
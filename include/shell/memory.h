@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+#include <shell/macros.h>
+
+namespace shell
+{
+
+class Arena : public std::pmr::memory_resource
+{
+public:
+    struct Marker
+    {
+        void* block = nullptr;
+        std::byte* cursor = nullptr;
+    };
+
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+
+    explicit Arena(std::size_t block_size = kBlockSize, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : _block_size(block_size), _upstream(upstream)
+    {
+        SHELL_ASSERT(block_size > 0);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena()
+    {
+        release();
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    Marker mark() const
+    {
+        return { _head, _cursor };
+    }
+
+    void rewind(const Marker& marker)
+    {
+        while (_head != marker.block)
+        {
+            SHELL_ASSERT(_head, "Marker does not belong to arena");
+
+            Block* next = _head->next;
+            _head->next = _spare;
+            _spare = _head;
+            _head = next;
+        }
+
+        if (_head)
+        {
+            _cursor = marker.cursor;
+            _end = _head->data() + _head->size;
+        }
+        else
+        {
+            _cursor = nullptr;
+            _end = nullptr;
+        }
+    }
+
+    void reset()
+    {
+        rewind(Marker{});
+    }
+
+    void release()
+    {
+        reset();
+
+        while (_spare)
+        {
+            Block* next = _spare->next;
+            _upstream->deallocate(_spare, sizeof(Block) + _spare->size, alignof(Block));
+            _spare = next;
+        }
+    }
+
+    std::pmr::memory_resource* upstream() const
+    {
+        return _upstream;
+    }
+
+protected:
+    void* do_allocate(std::size_t size, std::size_t align) override
+    {
+        if (std::byte* data = bump(size, align))
+            return data;
+
+        grow(size + align);
+        return bump(size, align);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        std::byte* data()
+        {
+            return reinterpret_cast<std::byte*>(this + 1);
+        }
+
+        Block* next;
+        std::size_t size;
+    };
+
+    std::byte* bump(std::size_t size, std::size_t align)
+    {
+        if (!_cursor)
+            return nullptr;
+
+        auto address = reinterpret_cast<std::uintptr_t>(_cursor);
+        auto aligned = (address + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+
+        std::byte* data = _cursor + (aligned - address);
+        if (data > _end || static_cast<std::size_t>(_end - data) < size)
+            return nullptr;
+
+        _cursor = data + size;
+        return data;
+    }
+
+    void grow(std::size_t minimum)
+    {
+        Block** link = &_spare;
+        while (*link && (*link)->size < minimum)
+            link = &(*link)->next;
+
+        Block* block = *link;
+        if (block)
+        {
+            *link = block->next;
+        }
+        else
+        {
+            std::size_t size = std::max(_block_size, minimum);
+            block = new (_upstream->allocate(sizeof(Block) + size, alignof(Block))) Block{ nullptr, size };
+        }
+
+        block->next = _head;
+        _head = block;
+        _cursor = block->data();
+        _end = _cursor + block->size;
+    }
+
+    std::size_t _block_size;
+    std::pmr::memory_resource* _upstream;
+    Block* _head = nullptr;
+    Block* _spare = nullptr;
+    std::byte* _cursor = nullptr;
+    std::byte* _end = nullptr;
+};
+
+template<typename T>
+class Pool
+{
+public:
+    static constexpr std::size_t kBlockSize = 64;
+
+    explicit Pool(std::size_t block_size = kBlockSize, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : _block_size(block_size), _upstream(upstream)
+    {
+        SHELL_ASSERT(block_size > 0);
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    ~Pool()
+    {
+        while (_blocks)
+        {
+            Slot* next = _blocks->next;
+            _upstream->deallocate(_blocks, (_block_size + 1) * sizeof(Slot), alignof(Slot));
+            _blocks = next;
+        }
+    }
+
+    T* allocate()
+    {
+        if (!_free)
+            grow();
+
+        Slot* slot = _free;
+        _free = slot->next;
+        return reinterpret_cast<T*>(slot->storage);
+    }
+
+    void deallocate(T* pointer)
+    {
+        Slot* slot = reinterpret_cast<Slot*>(pointer);
+        slot->next = _free;
+        _free = slot;
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        T* pointer = allocate();
+        try
+        {
+            return new (pointer) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(pointer);
+            throw;
+        }
+    }
+
+    void destroy(T* pointer)
+    {
+        std::destroy_at(pointer);
+        deallocate(pointer);
+    }
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void grow()
+    {
+        Slot* block = static_cast<Slot*>(_upstream->allocate((_block_size + 1) * sizeof(Slot), alignof(Slot)));
+
+        block[0].next = _blocks;
+        _blocks = block;
+
+        for (std::size_t i = _block_size; i > 0; --i)
+        {
+            block[i].next = _free;
+            _free = &block[i];
+        }
+    }
+
+    std::size_t _block_size;
+    std::pmr::memory_resource* _upstream;
+    Slot* _blocks = nullptr;
+    Slot* _free = nullptr;
+};
+
+}  // namespace shell
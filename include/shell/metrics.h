@@ -0,0 +1,446 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <shell/bit.h>
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/log/sinks.h>
+#include <shell/macros.h>
+#include <shell/predef.h>
+
+#if !SHELL_OS_WINDOWS
+#  include <cerrno>
+#  include <cstring>
+#  include <thread>
+#  include <poll.h>
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+namespace shell::metrics
+{
+
+namespace detail
+{
+
+inline constexpr std::size_t kShards = 16;
+
+inline std::size_t shard()
+{
+    static std::atomic<std::size_t> next = 0;
+    static thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return index;
+}
+
+}  // namespace detail
+
+class Counter
+{
+public:
+    SHELL_INLINE void add(u64 value = 1)
+    {
+        _shards[detail::shard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    u64 value() const
+    {
+        u64 sum = 0;
+        for (const auto& shard : _shards)
+            sum += shard.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<u64> value = 0;
+    };
+
+    std::array<Shard, detail::kShards> _shards;
+};
+
+class Gauge
+{
+public:
+    void set(s64 value)
+    {
+        _value.store(value, std::memory_order_relaxed);
+    }
+
+    void add(s64 value = 1)
+    {
+        _value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void sub(s64 value = 1)
+    {
+        _value.fetch_sub(value, std::memory_order_relaxed);
+    }
+
+    s64 value() const
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<s64> _value = 0;
+};
+
+// Log-linear buckets: values below 2^kPrecision are exact, every power of
+// two above is split into 2^kPrecision buckets (relative error < 6.25%).
+struct HistogramSnapshot
+{
+    static constexpr uint kPrecision = 4;
+    static constexpr std::size_t kBuckets = (64 - kPrecision + 1) << kPrecision;
+
+    static SHELL_INLINE std::size_t bucket(u64 value)
+    {
+        if (value < (1 << kPrecision))
+            return static_cast<std::size_t>(value);
+
+        uint shift = 63 - bit::clz(value) - kPrecision;
+        return ((shift + 1) << kPrecision) + static_cast<std::size_t>((value >> shift) - (1 << kPrecision));
+    }
+
+    static u64 lower(std::size_t bucket)
+    {
+        if (bucket < (1 << kPrecision))
+            return bucket;
+
+        uint shift = static_cast<uint>(bucket >> kPrecision) - 1;
+        return ((1 << kPrecision) + static_cast<u64>(bucket & ((1 << kPrecision) - 1))) << shift;
+    }
+
+    static u64 upper(std::size_t bucket)
+    {
+        return bucket + 1 < kBuckets ? lower(bucket + 1) - 1 : ~u64(0);
+    }
+
+    double mean() const
+    {
+        return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+
+    // Upper bound of the bucket holding the given percentile in [0, 100],
+    // clamped to the recorded range.
+    u64 percentile(double percentile) const
+    {
+        if (count == 0)
+            return 0;
+
+        double rank = std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(count));
+        u64 target = std::max<u64>(static_cast<u64>(rank), 1);
+
+        u64 seen = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+        {
+            seen += buckets[i];
+            if (seen >= target)
+                return clamp(upper(i));
+        }
+        return clamp(upper(kBuckets - 1));
+    }
+
+    void merge(const HistogramSnapshot& other)
+    {
+        for (std::size_t i = 0; i < kBuckets; ++i)
+            buckets[i] += other.buckets[i];
+
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    u64 clamp(u64 value) const
+    {
+        return min <= max ? std::clamp(value, min, max) : value;
+    }
+
+    std::vector<u64> buckets = std::vector<u64>(kBuckets);
+    u64 count = 0;
+    u64 sum = 0;
+    u64 min = ~u64(0);
+    u64 max = 0;
+};
+
+class Histogram
+{
+public:
+    SHELL_INLINE void record(u64 value)
+    {
+        _buckets[HistogramSnapshot::bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+
+        // Only written while the range still grows.
+        u64 min = _min.load(std::memory_order_relaxed);
+        while (value < min && !_min.compare_exchange_weak(min, value, std::memory_order_relaxed));
+
+        u64 max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+    }
+
+    template<typename Rep, typename Period>
+    SHELL_INLINE void record(std::chrono::duration<Rep, Period> duration)
+    {
+        record(static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    }
+
+    HistogramSnapshot snapshot() const
+    {
+        HistogramSnapshot snapshot;
+        for (std::size_t i = 0; i < HistogramSnapshot::kBuckets; ++i)
+        {
+            snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+            snapshot.count += snapshot.buckets[i];
+        }
+        snapshot.sum = _sum.load(std::memory_order_relaxed);
+        snapshot.min = _min.load(std::memory_order_relaxed);
+        snapshot.max = _max.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    std::array<std::atomic<u64>, HistogramSnapshot::kBuckets> _buckets{};
+    std::atomic<u64> _sum = 0;
+    std::atomic<u64> _min = ~u64(0);
+    std::atomic<u64> _max = 0;
+};
+
+struct Snapshot
+{
+    static constexpr std::array<double, 4> kQuantiles = { 0.5, 0.9, 0.99, 0.999 };
+
+    // Prometheus text exposition format, histograms are exported as summaries.
+    std::string toText() const
+    {
+        std::string text;
+        for (const auto& [name, value] : counters)
+            shell::formatTo(text, SHELL_FORMAT("# TYPE {} counter\n{} {}\n"), name, name, value);
+
+        for (const auto& [name, value] : gauges)
+            shell::formatTo(text, SHELL_FORMAT("# TYPE {} gauge\n{} {}\n"), name, name, value);
+
+        for (const auto& [name, histogram] : histograms)
+        {
+            shell::formatTo(text, SHELL_FORMAT("# TYPE {} summary\n"), name);
+            for (double quantile : kQuantiles)
+                shell::formatTo(text, SHELL_FORMAT("{}{{quantile=\"{}\"}} {}\n"), name, quantile, histogram.percentile(100 * quantile));
+
+            shell::formatTo(text, SHELL_FORMAT("{}_sum {}\n{}_count {}\n"), name, histogram.sum, name, histogram.count);
+        }
+        return text;
+    }
+
+    void sink(BasicSink& sink, Level level = Level::Info) const
+    {
+        static const std::string kLocation = "metrics";
+
+        for (const auto& [name, value] : counters)
+            sink.sink(LogRecord(level, shell::format(SHELL_FORMAT("{} {}"), name, value), kLocation));
+
+        for (const auto& [name, value] : gauges)
+            sink.sink(LogRecord(level, shell::format(SHELL_FORMAT("{} {}"), name, value), kLocation));
+
+        for (const auto& [name, histogram] : histograms)
+        {
+            sink.sink(LogRecord(level, shell::format(SHELL_FORMAT("{} count={} mean={:.1f} p50={} p90={} p99={} p999={}"),
+                name, histogram.count, histogram.mean(),
+                histogram.percentile(50), histogram.percentile(90), histogram.percentile(99), histogram.percentile(99.9)), kLocation));
+        }
+    }
+
+    std::vector<std::pair<std::string, u64>> counters;
+    std::vector<std::pair<std::string, s64>> gauges;
+    std::vector<std::pair<std::string, HistogramSnapshot>> histograms;
+};
+
+// Lookups take a lock, callers keep the returned reference for the hot path.
+class Registry
+{
+public:
+    Counter& counter(std::string_view name)
+    {
+        return get(_counters, name);
+    }
+
+    Gauge& gauge(std::string_view name)
+    {
+        return get(_gauges, name);
+    }
+
+    Histogram& histogram(std::string_view name)
+    {
+        return get(_histograms, name);
+    }
+
+    Snapshot snapshot() const
+    {
+        std::lock_guard lock(_mutex);
+
+        Snapshot snapshot;
+        for (const auto& [name, counter] : _counters)
+            snapshot.counters.emplace_back(name, counter->value());
+
+        for (const auto& [name, gauge] : _gauges)
+            snapshot.gauges.emplace_back(name, gauge->value());
+
+        for (const auto& [name, histogram] : _histograms)
+            snapshot.histograms.emplace_back(name, histogram->snapshot());
+
+        return snapshot;
+    }
+
+private:
+    template<typename T>
+    using Map = std::map<std::string, std::unique_ptr<T>, std::less<>>;
+
+    template<typename T>
+    T& get(Map<T>& map, std::string_view name)
+    {
+        std::lock_guard lock(_mutex);
+
+        auto iter = map.find(name);
+        if (iter == map.end())
+            iter = map.emplace(std::string(name), std::make_unique<T>()).first;
+
+        return *iter->second;
+    }
+
+    mutable std::mutex _mutex;
+    Map<Counter> _counters;
+    Map<Gauge> _gauges;
+    Map<Histogram> _histograms;
+};
+
+inline Registry& registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+#if !SHELL_OS_WINDOWS
+
+// Serves the text exposition of a registry on a local (AF_UNIX) socket,
+// one snapshot per connection.
+class Server
+{
+public:
+    explicit Server(const std::string& path, Registry& registry = metrics::registry())
+        : _path(path), _registry(registry)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path) || ::pipe(_wake) != 0)
+            return;
+
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        ::unlink(path.c_str());
+
+        _fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (_fd < 0
+            || ::bind(_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+            || ::listen(_fd, 8) != 0)
+        {
+            close();
+            return;
+        }
+
+        _thread = std::thread([this]() { serve(); });
+    }
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    ~Server()
+    {
+        if (_thread.joinable())
+        {
+            char byte = 0;
+            while (::write(_wake[1], &byte, 1) < 0 && errno == EINTR);
+            _thread.join();
+            ::unlink(_path.c_str());
+        }
+        close();
+    }
+
+    bool listening() const
+    {
+        return _fd >= 0;
+    }
+
+private:
+    void serve()
+    {
+        while (true)
+        {
+            pollfd fds[2] = { { _fd, POLLIN, 0 }, { _wake[0], POLLIN, 0 } };
+            if (::poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+
+            if (fds[1].revents)
+                return;
+
+            int client = ::accept(_fd, nullptr, nullptr);
+            if (client < 0)
+                continue;
+
+            #if SHELL_OS_MACOS
+            int enable = 1;
+            ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+            int flags = 0;
+            #else
+            int flags = MSG_NOSIGNAL;
+            #endif
+
+            std::string text = _registry.snapshot().toText();
+            for (std::size_t offset = 0; offset < text.size(); )
+            {
+                ssize_t written = ::send(client, text.data() + offset, text.size() - offset, flags);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                    break;
+
+                offset += static_cast<std::size_t>(written);
+            }
+            ::close(client);
+        }
+    }
+
+    void close()
+    {
+        for (int* fd : { &_fd, &_wake[0], &_wake[1] })
+        {
+            if (*fd >= 0)
+                ::close(std::exchange(*fd, -1));
+        }
+    }
+
+    std::string _path;
+    Registry& _registry;
+    int _fd = -1;
+    int _wake[2] = { -1, -1 };
+    std::thread _thread;
+};
+
+#endif
+
+}  // namespace shell::metrics
@@ -172,7 +172,7 @@ class OptionGroup : public OptionVector
         for (const auto& [spec, value] : *this)
         {
             std::string_view format = value->isOptional() ? " [{}]" : " {}";
-            args.append(shell::format(format, spec.argument()));
+            shell::formatTo(args, format, spec.argument());
         }
         return args;
     }
@@ -196,12 +196,13 @@ class OptionGroup : public OptionVector
 
         for (const auto [option, key] : zip(*this, keys))
         {
-            help.append(shell::format(
+            shell::formatTo(
+                help,
                 "  {:<{}}{}{}\n",
                 key,
                 padding + 4,
                 option.spec.desc,
-                option.value->help()));
+                option.value->help());
         }
         return help;
     }
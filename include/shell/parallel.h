@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <shell/functional.h>
+#include <shell/macros.h>
+#include <shell/ranges.h>
+
+namespace shell
+{
+
+class ThreadPool;
+
+namespace detail
+{
+
+class WorkQueue
+{
+public:
+    using Task = std::function<void()>;
+
+    void push(Task task)
+    {
+        std::lock_guard lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+
+    bool pop(Task& task)
+    {
+        std::lock_guard lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        task = std::move(_tasks.back());
+        _tasks.pop_back();
+        return true;
+    }
+
+    bool steal(Task& task)
+    {
+        std::lock_guard lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::deque<Task> _tasks;
+};
+
+struct Worker
+{
+    ThreadPool* pool = nullptr;
+    std::size_t index = 0;
+};
+
+inline Worker& currentWorker()
+{
+    static thread_local Worker worker;
+    return worker;
+}
+
+}  // namespace detail
+
+class ThreadPool
+{
+public:
+    using Task = detail::WorkQueue::Task;
+
+    explicit ThreadPool(std::size_t threads = std::max(1U, std::thread::hardware_concurrency()))
+        : _queues(std::max<std::size_t>(1, threads))
+    {
+        _workers.reserve(_queues.size());
+        for (std::size_t i = 0; i < _queues.size(); ++i)
+            _workers.emplace_back([this, i]() { work(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+
+        for (auto& worker : _workers)
+            worker.join();
+    }
+
+    static ThreadPool& global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    std::size_t size() const
+    {
+        return _workers.size();
+    }
+
+    void submit(Task task)
+    {
+        const auto& worker = detail::currentWorker();
+
+        std::size_t index = worker.pool == this
+            ? worker.index
+            : _next.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+
+        // Counted before the push so that a stealer never decrements first.
+        _pending.fetch_add(1);
+        _queues[index].push(std::move(task));
+
+        // A worker registers as sleeper before checking for pending tasks,
+        // taking the lock waits until it blocks and can be notified.
+        if (_sleepers.load() > 0)
+        {
+            std::unique_lock lock(_mutex);
+            lock.unlock();
+            _condition.notify_one();
+        }
+    }
+
+    bool runPending()
+    {
+        Task task;
+        if (!pop(task))
+            return false;
+
+        task();
+        return true;
+    }
+
+private:
+    bool pop(Task& task)
+    {
+        const auto& worker = detail::currentWorker();
+
+        std::size_t start = 0;
+        if (worker.pool == this)
+        {
+            start = worker.index;
+            if (_queues[start].pop(task))
+                return taken();
+        }
+
+        for (std::size_t i = 0; i < _queues.size(); ++i)
+        {
+            if (_queues[(start + i) % _queues.size()].steal(task))
+                return taken();
+        }
+        return false;
+    }
+
+    bool taken()
+    {
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void work(std::size_t index)
+    {
+        detail::currentWorker() = { this, index };
+
+        while (true)
+        {
+            if (runPending())
+                continue;
+
+            std::unique_lock lock(_mutex);
+            _sleepers.fetch_add(1);
+            _condition.wait(lock, [this]()
+            {
+                return _stop || _pending.load() > 0;
+            });
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (_stop && _pending.load() == 0)
+                return;
+        }
+    }
+
+    std::vector<detail::WorkQueue> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<std::size_t> _next = 0;
+    std::atomic<std::size_t> _pending = 0;
+    std::atomic<std::size_t> _sleepers = 0;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stop = false;
+};
+
+namespace detail
+{
+
+inline constexpr std::size_t kParallelChunks = 256;
+
+template<typename Range>
+using parallel_iterator_t = decltype(std::begin(std::declval<Range&>()));
+
+inline std::size_t chunkSize(std::size_t size, std::size_t chunk)
+{
+    if (chunk == 0)
+        chunk = (size + kParallelChunks - 1) / kParallelChunks;
+
+    return std::max<std::size_t>(chunk, 1);
+}
+
+template<typename Function>
+void parallelChunks(ThreadPool& pool, std::size_t size, std::size_t chunk, Function func)
+{
+    if (size == 0)
+        return;
+
+    chunk = chunkSize(size, chunk);
+
+    std::size_t chunks = (size + chunk - 1) / chunk;
+    if (chunks == 1)
+    {
+        func(0, 0, size);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(chunks);
+    std::atomic<std::size_t> remaining = chunks - 1;
+
+    auto process = [&](std::size_t index)
+    {
+        try
+        {
+            func(index, index * chunk, std::min(size, (index + 1) * chunk));
+        }
+        catch (...)
+        {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    for (std::size_t i = 1; i < chunks; ++i)
+    {
+        pool.submit([&process, &remaining, i]()
+        {
+            process(i);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    process(0);
+
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!pool.runPending())
+            std::this_thread::yield();
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+}  // namespace detail
+
+template<typename Range, typename Function>
+void parallelForeach(ThreadPool& pool, Range&& range, Function func, std::size_t chunk = 0)
+{
+    detail::assertRandomAccess<detail::parallel_iterator_t<Range>>();
+
+    auto first = std::begin(range);
+    auto size  = static_cast<std::size_t>(std::distance(first, std::end(range)));
+
+    detail::parallelChunks(pool, size, chunk, [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+        std::for_each(first + begin, first + end, func);
+    });
+}
+
+template<typename Range, typename Function>
+void parallelForeach(Range&& range, Function func, std::size_t chunk = 0)
+{
+    parallelForeach(ThreadPool::global(), std::forward<Range>(range), func, chunk);
+}
+
+template<typename Range, typename OutputIterator, typename Function>
+OutputIterator parallelTransform(ThreadPool& pool, Range&& range, OutputIterator out, Function func, std::size_t chunk = 0)
+{
+    detail::assertRandomAccess<detail::parallel_iterator_t<Range>>();
+
+    auto first = std::begin(range);
+    auto size  = static_cast<std::size_t>(std::distance(first, std::end(range)));
+
+    detail::parallelChunks(pool, size, chunk, [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+        std::transform(first + begin, first + end, out + begin, func);
+    });
+
+    return out + size;
+}
+
+template<typename Range, typename OutputIterator, typename Function>
+OutputIterator parallelTransform(Range&& range, OutputIterator out, Function func, std::size_t chunk = 0)
+{
+    return parallelTransform(ThreadPool::global(), std::forward<Range>(range), out, func, chunk);
+}
+
+// Chunks start from the transform of their first element rather than
+// from init, which therefore does not need to be an identity element.
+template<typename Range, typename T, typename Reduce, typename Transform>
+T parallelTransformReduce(ThreadPool& pool, Range&& range, T init, Reduce reduce, Transform transform, std::size_t chunk = 0)
+{
+    detail::assertRandomAccess<detail::parallel_iterator_t<Range>>();
+
+    auto first = std::begin(range);
+    auto size  = static_cast<std::size_t>(std::distance(first, std::end(range)));
+    if (size == 0)
+        return init;
+
+    chunk = detail::chunkSize(size, chunk);
+
+    std::vector<std::optional<T>> partials((size + chunk - 1) / chunk);
+
+    detail::parallelChunks(pool, size, chunk, [&](std::size_t index, std::size_t begin, std::size_t end)
+    {
+        T partial = transform(first[begin]);
+        for (auto iter = first + begin + 1; iter != first + end; ++iter)
+            partial = reduce(std::move(partial), transform(*iter));
+
+        partials[index] = std::move(partial);
+    });
+
+    for (auto& partial : partials)
+        init = reduce(std::move(init), std::move(*partial));
+
+    return init;
+}
+
+template<typename Range, typename T, typename Reduce, typename Transform>
+T parallelTransformReduce(Range&& range, T init, Reduce reduce, Transform transform, std::size_t chunk = 0)
+{
+    return parallelTransformReduce(ThreadPool::global(), std::forward<Range>(range), init, reduce, transform, chunk);
+}
+
+template<typename Range, typename T, typename Function>
+T parallelReduce(ThreadPool& pool, Range&& range, T init, Function func, std::size_t chunk = 0)
+{
+    return parallelTransformReduce(pool, std::forward<Range>(range), init, func, Identity{}, chunk);
+}
+
+template<typename Range, typename T, typename Function>
+T parallelReduce(Range&& range, T init, Function func, std::size_t chunk = 0)
+{
+    return parallelReduce(ThreadPool::global(), std::forward<Range>(range), init, func, chunk);
+}
+
+}  // namespace shell
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <charconv>
 #include <limits>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include <shell/algorithm.h>
 
@@ -16,7 +20,7 @@ namespace detail
 class Validator
 {
 public:
-    Validator(const std::string& data)
+    Validator(std::string_view data)
         : _data(data) {}
 
     operator bool() const
@@ -40,9 +44,14 @@ class Validator
 
 private:
     std::size_t _index = 0;
-    const std::string& _data;
+    std::string_view _data;
 };
 
+inline char lower(char ch)
+{
+    return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
 template<typename T>
 class IsSignChar
 {
@@ -61,6 +70,7 @@ class IsNumericChar
 
     bool operator()(char ch) const
     {
+        ch = lower(ch);
         if (_base <= 10)
         {
             return (ch >= '0') && (ch < ('0' + _base));
@@ -91,42 +101,63 @@ class IsExponentChar
 public:
     bool operator()(char ch) const
     {
-        return ch == 'e';
+        return lower(ch) == 'e';
     }
 };
 
+// Numbers are converted with from_chars, which needs neither a copy of
+// the input nor a locale.
 template<typename T>
-std::optional<T> parseInt(T(*parse)(const std::string&, std::size_t*, int), std::string data)
+std::optional<T> parseInt(std::string_view data)
 {
+    using Unsigned = std::make_unsigned_t<T>;
+
     trim(data);
-    toLower(data);
+
+    bool negative = false;
+    if (!data.empty() && IsSignChar<T>()(data.front()))
+    {
+        negative = data.front() == '-';
+        data.remove_prefix(1);
+    }
 
     int base = 10;
-    if (startsWith(data, "0b") || startsWith(data, "+0b") || startsWith(data, "-0b")) { base =  2; replaceFirst(data, "0b", ""); }
-    if (startsWith(data, "0x") || startsWith(data, "+0x") || startsWith(data, "-0x")) { base = 16; replaceFirst(data, "0x", ""); }
+    if (data.size() >= 2 && data[0] == '0' && (lower(data[1]) == 'b' || lower(data[1]) == 'x'))
+    {
+        base = lower(data[1]) == 'b' ? 2 : 16;
+        data.remove_prefix(2);
+    }
 
     Validator validator(data);
-    validator.one(IsSignChar<T>());
     validator.all(IsNumericChar(base));
 
     if (!validator)
         return std::nullopt;
 
-    try
+    Unsigned magnitude = 0;
+    auto [end, error] = std::from_chars(data.data(), data.data() + data.size(), magnitude, base);
+    if (error != std::errc() || end != data.data() + data.size())
+        return std::nullopt;
+
+    constexpr auto kMax = static_cast<Unsigned>(std::numeric_limits<T>::max());
+    if (!negative)
     {
-        return parse(data, nullptr, base);
+        if (magnitude > kMax)
+            return std::nullopt;
+
+        return static_cast<T>(magnitude);
     }
-    catch (const std::logic_error&)
-    {
+
+    if (magnitude > kMax + 1)
         return std::nullopt;
-    }
+
+    return magnitude == 0 ? T(0) : static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
 }
 
 template<typename T>
-std::optional<T> parseRat(T(*parse)(const std::string&, std::size_t*), std::string data)
+std::optional<T> parseRat(std::string_view data)
 {
     trim(data);
-    toLower(data);
 
     Validator validator(data);
     validator.one(IsSignChar<T>());
@@ -140,23 +171,30 @@ std::optional<T> parseRat(T(*parse)(const std::string&, std::size_t*), std::stri
     if (!validator)
         return std::nullopt;
 
-    try
-    {
-        return parse(data, nullptr);
-    }
-    catch (const std::logic_error&)
-    {
+    if (!data.empty() && data.front() == '+')
+        data.remove_prefix(1);
+
+    T value{};
+    auto [end, error] = std::from_chars(data.data(), data.data() + data.size(), value);
+    if (error != std::errc())
         return std::nullopt;
-    }
+
+    return value;
+}
+
+inline bool equalsLower(std::string_view data, std::string_view lowercase)
+{
+    return data.size() == lowercase.size()
+        && std::equal(data.begin(), data.end(), lowercase.begin(), [](char a, char b) { return lower(a) == b; });
 }
 
 }  // namespace detail
 
 template<typename T>
-std::optional<T> parse(const std::string& data)
+std::optional<T> parse(std::string_view data)
 {
     T value{};
-    std::stringstream stream(data);
+    std::stringstream stream{ std::string(data) };
     stream >> value;
 
     return stream
@@ -165,73 +203,66 @@ std::optional<T> parse(const std::string& data)
 }
 
 template<>
-inline std::optional<std::string> parse(const std::string& data)
+inline std::optional<std::string> parse(std::string_view data)
 {
-    return data;
+    return std::string(data);
 }
 
 template<>
-inline std::optional<bool> parse(const std::string& data)
+inline std::optional<bool> parse(std::string_view data)
 {
-    std::string value = toLowerCopy(data);
-
-    if (value == "1" || value == "true")  return true;
-    if (value == "0" || value == "false") return false;
+    if (detail::equalsLower(data, "1") || detail::equalsLower(data, "true"))  return true;
+    if (detail::equalsLower(data, "0") || detail::equalsLower(data, "false")) return false;
 
     return std::nullopt;
 }
 
 template<>
-inline std::optional<int> parse(const std::string& data)
+inline std::optional<int> parse(std::string_view data)
 {
-    return detail::parseInt<int>(std::stoi, data);
+    return detail::parseInt<int>(data);
 }
 
 template<>
-inline std::optional<long> parse(const std::string& data)
+inline std::optional<long> parse(std::string_view data)
 {
-    return detail::parseInt<long>(std::stol, data);
+    return detail::parseInt<long>(data);
 }
 
 template<>
-inline std::optional<unsigned long> parse(const std::string& data)
+inline std::optional<unsigned long> parse(std::string_view data)
 {
-    return detail::parseInt<unsigned long>(std::stoul, data);
+    return detail::parseInt<unsigned long>(data);
 }
 
 template<>
-inline std::optional<long long> parse(const std::string& data)
+inline std::optional<long long> parse(std::string_view data)
 {
-    return detail::parseInt<long long>(std::stoll, data);
+    return detail::parseInt<long long>(data);
 }
 
 template<>
-inline std::optional<unsigned long long> parse(const std::string& data)
+inline std::optional<unsigned long long> parse(std::string_view data)
 {
-    return detail::parseInt<unsigned long long>(std::stoull, data);
+    return detail::parseInt<unsigned long long>(data);
 }
 
 template<>
-inline std::optional<unsigned int> parse(const std::string& data)
+inline std::optional<unsigned int> parse(std::string_view data)
 {
-    if (const auto value = parse<unsigned long>(data))
-    {
-        if (*value <= std::numeric_limits<unsigned int>::max())
-            return static_cast<unsigned int>(*value);
-    }
-    return std::nullopt;
+    return detail::parseInt<unsigned int>(data);
 }
 
 template<>
-inline std::optional<float> parse(const std::string& data)
+inline std::optional<float> parse(std::string_view data)
 {
-    return detail::parseRat<float>(std::stof, data);
+    return detail::parseRat<float>(data);
 }
 
 template<>
-inline std::optional<double> parse(const std::string& data)
+inline std::optional<double> parse(std::string_view data)
 {
-    return detail::parseRat<double>(std::stod, data);
+    return detail::parseRat<double>(data);
 }
 
 }  // namespace shell
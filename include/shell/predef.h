@@ -38,6 +38,26 @@
 #  define SHELL_CC_MINGW 0
 #endif
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define SHELL_ARCH_X86 1
+#else
+#  define SHELL_ARCH_X86 0
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define SHELL_ARCH_X64 1
+#else
+#  define SHELL_ARCH_X64 0
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#  define SHELL_ENDIAN_BIG    1
+#  define SHELL_ENDIAN_LITTLE 0
+#else
+#  define SHELL_ENDIAN_BIG    0
+#  define SHELL_ENDIAN_LITTLE 1
+#endif
+
 #ifdef _WIN32
 #  define SHELL_OS_WINDOWS 1
 #else
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <shell/bitstream.h>
+#include <shell/filesystem.h>
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/macros.h>
+#include <shell/predef.h>
+
+#if SHELL_ARCH_X64
+#  if SHELL_CC_MSVC
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#endif
+
+namespace shell
+{
+
+namespace detail
+{
+
+SHELL_INLINE u64 ticks()
+{
+    #if SHELL_ARCH_X64
+    return __rdtsc();
+    #else
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    #endif
+}
+
+class ProfileBuffer
+{
+public:
+    struct Event
+    {
+        const char* name;
+        u64 begin;
+        u64 end;
+    };
+
+    explicit ProfileBuffer(u32 thread)
+        : _thread(thread), _head(new Chunk), _tail(_head) {}
+
+    ProfileBuffer(const ProfileBuffer&) = delete;
+    ProfileBuffer& operator=(const ProfileBuffer&) = delete;
+
+    ~ProfileBuffer()
+    {
+        while (_head)
+            delete std::exchange(_head, _head->next.load(std::memory_order_relaxed));
+    }
+
+    SHELL_INLINE void push(const char* name, u64 begin, u64 end)
+    {
+        u32 size = _tail->size.load(std::memory_order_relaxed);
+        if (size == Chunk::kSize)
+        {
+            grow();
+            size = 0;
+        }
+
+        _tail->events[size] = { name, begin, end };
+        _tail->size.store(size + 1, std::memory_order_release);
+    }
+
+    // Called by a single consumer at a time. Full chunks are freed once
+    // consumed, the producer only ever touches the last one.
+    template<typename Function>
+    void consume(Function func)
+    {
+        while (true)
+        {
+            u32 size = _head->size.load(std::memory_order_acquire);
+            for (; _read < size; ++_read)
+                func(_head->events[_read]);
+
+            Chunk* next = _head->next.load(std::memory_order_acquire);
+            if (_read < Chunk::kSize || !next)
+                return;
+
+            delete std::exchange(_head, next);
+            _read = 0;
+        }
+    }
+
+    u32 thread() const
+    {
+        return _thread;
+    }
+
+private:
+    struct Chunk
+    {
+        static constexpr u32 kSize = 4096;
+
+        Event events[kSize];
+        std::atomic<u32> size = 0;
+        std::atomic<Chunk*> next = nullptr;
+    };
+
+    SHELL_NO_INLINE void grow()
+    {
+        Chunk* chunk = new Chunk;
+        _tail->next.store(chunk, std::memory_order_release);
+        _tail = chunk;
+    }
+
+    u32 _thread;
+    Chunk* _head;
+    Chunk* _tail;
+    u32 _read = 0;
+};
+
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Profiler& instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    std::shared_ptr<ProfileBuffer> attach()
+    {
+        std::lock_guard lock(_mutex);
+        auto buffer = std::make_shared<ProfileBuffer>(static_cast<u32>(_threads++));
+        _buffers.push_back(buffer);
+        return buffer;
+    }
+
+    template<typename Function>
+    void consume(Function func)
+    {
+        std::lock_guard lock(_mutex);
+        for (auto iter = _buffers.begin(); iter != _buffers.end(); )
+        {
+            auto& buffer = *iter;
+            bool exited = buffer.use_count() == 1;
+            buffer->consume([&](const ProfileBuffer::Event& event)
+            {
+                func(buffer->thread(), event);
+            });
+
+            // Buffers of exited threads are dropped once drained.
+            iter = exited ? _buffers.erase(iter) : std::next(iter);
+        }
+    }
+
+    double nanosecondsPerTick()
+    {
+        #if SHELL_ARCH_X64
+        auto elapsed = Clock::now() - _time;
+        if (elapsed < std::chrono::milliseconds(10))
+            std::this_thread::sleep_for(std::chrono::milliseconds(10) - elapsed);
+
+        u64 ticks = detail::ticks();
+        auto time = Clock::now();
+        return std::chrono::duration<double, std::nano>(time - _time).count() / static_cast<double>(ticks - _ticks);
+        #else
+        return 1.0;
+        #endif
+    }
+
+    u64 origin() const
+    {
+        return _ticks;
+    }
+
+private:
+    Profiler()
+        : _ticks(detail::ticks()), _time(Clock::now()) {}
+
+    u64 _ticks;
+    Clock::time_point _time;
+    std::mutex _mutex;
+    std::size_t _threads = 0;
+    std::vector<std::shared_ptr<ProfileBuffer>> _buffers;
+};
+
+SHELL_INLINE ProfileBuffer& profileBuffer()
+{
+    static thread_local std::shared_ptr<ProfileBuffer> buffer = Profiler::instance().attach();
+    return *buffer;
+}
+
+inline void escapeJson(std::string& dst, std::string_view src)
+{
+    for (char c : src)
+    {
+        switch (c)
+        {
+        case '"':  dst += "\\\""; break;
+        case '\\': dst += "\\\\"; break;
+        case '\n': dst += "\\n"; break;
+        case '\t': dst += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                shell::formatTo(dst, SHELL_FORMAT("\\u{:04x}"), static_cast<int>(c));
+            else
+                dst += c;
+            break;
+        }
+    }
+}
+
+}  // namespace detail
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : _buffer(detail::profileBuffer()), _name(name), _begin(detail::ticks()) {}
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ~ProfileScope()
+    {
+        _buffer.push(_name, _begin, detail::ticks());
+    }
+
+private:
+    detail::ProfileBuffer& _buffer;
+    const char* _name;
+    u64 _begin;
+};
+
+class Profile
+{
+public:
+    enum class Format { Chrome, Binary };
+
+    struct Event
+    {
+        u32 name = 0;
+        u32 thread = 0;
+        u64 begin = 0;
+        u64 duration = 0;
+    };
+
+    static constexpr u8 kVersion = 1;
+
+    // Takes all events recorded since the previous capture, in nanoseconds
+    // since the profiler started.
+    static Profile capture()
+    {
+        auto& profiler = detail::Profiler::instance();
+        double scale = profiler.nanosecondsPerTick();
+        u64 origin = profiler.origin();
+
+        Profile profile;
+        std::unordered_map<std::string_view, u32> names;
+        profiler.consume([&](u32 thread, const detail::ProfileBuffer::Event& event)
+        {
+            auto [iter, inserted] = names.try_emplace(event.name, static_cast<u32>(profile.names.size()));
+            if (inserted)
+                profile.names.emplace_back(event.name);
+
+            Event& dst = profile.events.emplace_back();
+            dst.name = iter->second;
+            dst.thread = thread;
+            dst.begin = static_cast<u64>(static_cast<double>(event.begin - origin) * scale);
+            dst.duration = static_cast<u64>(static_cast<double>(event.end - event.begin) * scale);
+        });
+
+        std::stable_sort(profile.events.begin(), profile.events.end(), [](const Event& a, const Event& b)
+        {
+            return a.begin < b.begin;
+        });
+        return profile;
+    }
+
+    static std::optional<Profile> load(const filesystem::path& file)
+    {
+        auto [status, data] = filesystem::read<std::vector<u8>>(file);
+        if (status != filesystem::Status::Ok)
+            return std::nullopt;
+
+        return fromBinary(data);
+    }
+
+    static std::optional<Profile> fromBinary(const std::vector<u8>& data)
+    {
+        if (data.size() < 5 || std::string_view(reinterpret_cast<const char*>(data.data()), 4) != "SHLP" || data[4] != kVersion)
+            return std::nullopt;
+
+        bit::BitReader<> reader(data.data() + 5, data.size() - 5);
+
+        bool truncated = false;
+        auto count = [&]() -> std::size_t
+        {
+            std::size_t count = reader.readVarint<std::size_t>();
+            if (count <= reader.remaining() / 8)
+                return count;
+
+            truncated = true;
+            return 0;
+        };
+
+        Profile profile;
+        profile.names.resize(count());
+        for (auto& name : profile.names)
+        {
+            name.resize(count());
+            for (auto& c : name)
+                c = static_cast<char>(reader.read(8));
+
+            if (reader.overrun())
+                return std::nullopt;
+        }
+
+        profile.events.resize(count());
+        u64 begin = 0;
+        for (auto& event : profile.events)
+        {
+            event.name = reader.readVarint<u32>();
+            event.thread = reader.readVarint<u32>();
+            event.begin = begin += reader.readVarint<u64>();
+            event.duration = reader.readVarint<u64>();
+
+            if (reader.overrun() || event.name >= profile.names.size())
+                return std::nullopt;
+        }
+
+        if (truncated || reader.overrun())
+            return std::nullopt;
+
+        return profile;
+    }
+
+    std::string toChromeTrace() const
+    {
+        std::string json = "{\"traceEvents\":[";
+        for (const auto& event : events)
+        {
+            if (&event != events.data())
+                json += ',';
+
+            json += "\n{\"name\":\"";
+            detail::escapeJson(json, names[event.name]);
+            shell::formatTo(json, SHELL_FORMAT("\",\"ph\":\"X\",\"ts\":{}.{:03},\"dur\":{}.{:03},\"pid\":0,\"tid\":{}}}"),
+                event.begin / 1000, event.begin % 1000, event.duration / 1000, event.duration % 1000, event.thread);
+        }
+        json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+        return json;
+    }
+
+    std::vector<u8> toBinary() const
+    {
+        std::size_t size = 5 + 2 * 10 + 30 * events.size();
+        for (const auto& name : names)
+            size += 10 + name.size();
+
+        std::vector<u8> data(size);
+        std::copy_n("SHLP", 4, data.begin());
+        data[4] = kVersion;
+
+        bit::BitWriter<> writer(data.data() + 5, data.size() - 5);
+        writer.writeVarint(names.size());
+        for (const auto& name : names)
+        {
+            writer.writeVarint(name.size());
+            for (char c : name)
+                writer.write(static_cast<u8>(c), 8);
+        }
+
+        writer.writeVarint(events.size());
+        u64 begin = 0;
+        for (const auto& event : events)
+        {
+            writer.writeVarint(event.name);
+            writer.writeVarint(event.thread);
+            writer.writeVarint(event.begin - begin);
+            writer.writeVarint(event.duration);
+            begin = event.begin;
+        }
+
+        data.resize(5 + writer.flush());
+        return data;
+    }
+
+    bool dump(const filesystem::path& file, Format format = Format::Chrome) const
+    {
+        filesystem::Status status = format == Format::Chrome
+            ? filesystem::write(file, toChromeTrace())
+            : filesystem::write(file, toBinary());
+
+        return status == filesystem::Status::Ok;
+    }
+
+    std::vector<std::string> names;
+    std::vector<Event> events;
+};
+
+}  // namespace shell
+
+#ifndef SHELL_NO_PROFILE
+#  define SHELL_PROFILE_SCOPE(name) shell::ProfileScope SHELL_CONCAT(shell_profile_, __LINE__)(name)
+#else
+#  define SHELL_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#define SHELL_PROFILE_FUNCTION() SHELL_PROFILE_SCOPE(SHELL_FUNCTION)
@@ -1,21 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
 
 #include <shell/int.h>
+#include <shell/macros.h>
 #include <shell/mp.h>
 #include <shell/traits.h>
 
 namespace shell
 {
 
-#define SHELL_FORWARD_ITERATORS(Begin, End)                          \
-          iterator begin()        { return       iterator(Begin); }  \
-          iterator end()          { return       iterator(End);   }  \
-    const_iterator begin()  const { return const_iterator(Begin); }  \
-    const_iterator end()    const { return const_iterator(End);   }  \
-    const_iterator cbegin() const { return const_iterator(Begin); }  \
-    const_iterator cend()   const { return const_iterator(End);   }
+#define SHELL_FORWARD_ITERATORS(Begin, End)                                    \
+    constexpr       iterator begin()        { return       iterator(Begin); }  \
+    constexpr       iterator end()          { return       iterator(End);   }  \
+    constexpr const_iterator begin()  const { return const_iterator(Begin); }  \
+    constexpr const_iterator end()    const { return const_iterator(End);   }  \
+    constexpr const_iterator cbegin() const { return const_iterator(Begin); }  \
+    constexpr const_iterator cend()   const { return const_iterator(End);   }
 
 template<typename Iterator>
 class ForwardRange
@@ -34,13 +38,13 @@ class ForwardRange
     const Iterator _end;
 };
 
-#define SHELL_REVERSE_ITERATORS(Begin, End)                                           \
-          reverse_iterator rbegin()        { return       reverse_iterator(Begin); }  \
-          reverse_iterator rend()          { return       reverse_iterator(End);   }  \
-    const_reverse_iterator rbegin()  const { return const_reverse_iterator(Begin); }  \
-    const_reverse_iterator rend()    const { return const_reverse_iterator(End);   }  \
-    const_reverse_iterator crbegin() const { return const_reverse_iterator(Begin); }  \
-    const_reverse_iterator crend()   const { return const_reverse_iterator(End);   }
+#define SHELL_REVERSE_ITERATORS(Begin, End)                                                     \
+    constexpr       reverse_iterator rbegin()        { return       reverse_iterator(Begin); }  \
+    constexpr       reverse_iterator rend()          { return       reverse_iterator(End);   }  \
+    constexpr const_reverse_iterator rbegin()  const { return const_reverse_iterator(Begin); }  \
+    constexpr const_reverse_iterator rend()    const { return const_reverse_iterator(End);   }  \
+    constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(Begin); }  \
+    constexpr const_reverse_iterator crend()   const { return const_reverse_iterator(End);   }
 
 template<typename Iterator>
 class BidirectionalRange
@@ -105,26 +109,46 @@ class ByteRange : public BidirectionalRange<Byte*>
         : ByteRange(&value) {}
 };
 
+namespace detail
+{
+
+// zip and enumerate only build an exact end for random access ranges, the
+// end of weaker ranges compares lazily and cannot be decremented.
+template<typename... Iterators>
+using adaptor_category_t = std::conditional_t<
+    std::is_same_v<common_iterator_category_t<Iterators...>, std::bidirectional_iterator_tag>,
+    std::forward_iterator_tag,
+    common_iterator_category_t<Iterators...>>;
+
+}  // namespace detail
+
 template<typename Integral, typename Iterator>
 class EnumerateIterator
 {
 public:
     static_assert(std::is_integral_v<Integral>);
 
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = detail::adaptor_category_t<Iterator>;
     using difference_type   = std::ptrdiff_t;
     using value_type        = std::tuple<Integral, dereferenced_t<Iterator>>;
-    using reference         = value_type&;
-    using pointer           = value_type*;
+    using reference         = value_type;
+    using pointer           = void;
 
-    EnumerateIterator(Integral index, Iterator begin, Iterator end)
-        : _index(index), _iter(begin), _end(end) {}
+    EnumerateIterator() = default;
 
-    value_type operator*() const
+    EnumerateIterator(Integral index, Iterator iter)
+        : _index(index), _iter(iter) {}
+
+    reference operator*() const
     {
         return { _index, *_iter };
     }
 
+    reference operator[](difference_type offset) const
+    {
+        return { static_cast<Integral>(_index + offset), _iter[offset] };
+    }
+
     EnumerateIterator& operator++()
     {
         ++_iter;
@@ -132,39 +156,108 @@ class EnumerateIterator
         return *this;
     }
 
+    EnumerateIterator operator++(int)
+    {
+        EnumerateIterator iter(*this);
+        ++*this;
+        return iter;
+    }
+
+    EnumerateIterator& operator--()
+    {
+        --_iter;
+        --_index;
+        return *this;
+    }
+
+    EnumerateIterator operator--(int)
+    {
+        EnumerateIterator iter(*this);
+        --*this;
+        return iter;
+    }
+
+    EnumerateIterator& operator+=(difference_type offset)
+    {
+        _iter += offset;
+        _index = static_cast<Integral>(_index + offset);
+        return *this;
+    }
+
+    EnumerateIterator& operator-=(difference_type offset)
+    {
+        return *this += -offset;
+    }
+
+    EnumerateIterator operator+(difference_type offset) const
+    {
+        return EnumerateIterator(*this) += offset;
+    }
+
+    EnumerateIterator operator-(difference_type offset) const
+    {
+        return EnumerateIterator(*this) -= offset;
+    }
+
+    friend EnumerateIterator operator+(difference_type offset, const EnumerateIterator& iter)
+    {
+        return iter + offset;
+    }
+
+    difference_type operator-(const EnumerateIterator& other) const
+    {
+        return _iter - other._iter;
+    }
+
     bool operator==(const EnumerateIterator& other) const
     {
-        return _index == other._index && _iter == other._iter && _end == other._end;
+        return _iter == other._iter;
     }
 
     bool operator!=(const EnumerateIterator& other) const
     {
-        return !(*this == other);
+        return _iter != other._iter;
     }
 
-    bool operator==(Sentinel) const
+    bool operator<(const EnumerateIterator& other) const
     {
-        return _iter == _end;
+        return _iter < other._iter;
     }
 
-    bool operator!=(Sentinel) const
+    bool operator>(const EnumerateIterator& other) const
     {
-        return !(*this == Sentinel{});
+        return _iter > other._iter;
+    }
+
+    bool operator<=(const EnumerateIterator& other) const
+    {
+        return _iter <= other._iter;
+    }
+
+    bool operator>=(const EnumerateIterator& other) const
+    {
+        return _iter >= other._iter;
     }
 
 private:
-    Integral _index;
+    Integral _index = 0;
     Iterator _iter;
-    const Iterator _end;
 };
 
 template<typename Range, typename Integral = std::size_t>
-SentinelRange<EnumerateIterator<Integral, range_iterator_t<Range>>>
+ForwardRange<EnumerateIterator<Integral, range_iterator_t<Range>>>
     enumerate(Range& range, Integral start = 0)
 {
     using Iterator = EnumerateIterator<Integral, range_iterator_t<Range>>;
 
-    return { Iterator(start, std::begin(range), std::end(range)) };
+    auto begin = std::begin(range);
+    auto end   = std::end(range);
+
+    Integral last = start;
+    if constexpr (std::is_same_v<typename Iterator::iterator_category, std::random_access_iterator_tag>)
+        last = static_cast<Integral>(start + (end - begin));
+
+    return { Iterator(start, begin), Iterator(last, end) };
 }
 
 template<typename... Iterators>
@@ -173,34 +266,95 @@ class ZipIterator
 public:
     static_assert(sizeof...(Iterators) > 0);
 
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = detail::adaptor_category_t<Iterators...>;
     using difference_type   = std::ptrdiff_t;
     using value_type        = std::tuple<dereferenced_t<Iterators>...>;
-    using reference         = value_type&;
-    using pointer           = value_type*;
+    using reference         = value_type;
+    using pointer           = void;
+
+    ZipIterator() = default;
 
-    ZipIterator(Iterators... begins, mp::first_t<Iterators...> end)
-        : _iters(begins...), _end(end) {}
+    ZipIterator(Iterators... iters)
+        : _iters(iters...) {}
 
-    value_type operator*() const
+    reference operator*() const
     {
-        auto dereference = [](const Iterators&... iters) -> value_type { return { *iters... }; } ;
+        auto dereference = [](const Iterators&... iters) -> value_type { return { *iters... }; };
 
         return std::apply(dereference, _iters);
     }
 
+    reference operator[](difference_type offset) const
+    {
+        auto subscript = [offset](const Iterators&... iters) -> value_type { return { iters[offset]... }; };
+
+        return std::apply(subscript, _iters);
+    }
+
     ZipIterator& operator++()
     {
-        auto advance = [](Iterators&... iters) { (++iters, ...); };
+        std::apply([](Iterators&... iters) { (++iters, ...); }, _iters);
+        return *this;
+    }
+
+    ZipIterator operator++(int)
+    {
+        ZipIterator iter(*this);
+        ++*this;
+        return iter;
+    }
+
+    ZipIterator& operator--()
+    {
+        std::apply([](Iterators&... iters) { (--iters, ...); }, _iters);
+        return *this;
+    }
 
-        std::apply(advance, _iters);
+    ZipIterator operator--(int)
+    {
+        ZipIterator iter(*this);
+        --*this;
+        return iter;
+    }
 
+    ZipIterator& operator+=(difference_type offset)
+    {
+        std::apply([offset](Iterators&... iters) { ((iters += offset), ...); }, _iters);
         return *this;
     }
 
+    ZipIterator& operator-=(difference_type offset)
+    {
+        return *this += -offset;
+    }
+
+    ZipIterator operator+(difference_type offset) const
+    {
+        return ZipIterator(*this) += offset;
+    }
+
+    ZipIterator operator-(difference_type offset) const
+    {
+        return ZipIterator(*this) -= offset;
+    }
+
+    friend ZipIterator operator+(difference_type offset, const ZipIterator& iter)
+    {
+        return iter + offset;
+    }
+
+    difference_type operator-(const ZipIterator& other) const
+    {
+        return std::get<0>(_iters) - std::get<0>(other._iters);
+    }
+
+    // Without random access, iteration stops when any range reaches its end.
     bool operator==(const ZipIterator& other) const
     {
-        return _iters == other._iters && _end == other._end;
+        if constexpr (std::is_same_v<iterator_category, std::random_access_iterator_tag>)
+            return std::get<0>(_iters) == std::get<0>(other._iters);
+        else
+            return equalAny(other, std::index_sequence_for<Iterators...>{});
     }
 
     bool operator!=(const ZipIterator& other) const
@@ -208,27 +362,410 @@ class ZipIterator
         return !(*this == other);
     }
 
-    bool operator==(Sentinel) const
+    bool operator<(const ZipIterator& other) const
     {
-        return std::get<0>(_iters) == _end;
+        return std::get<0>(_iters) < std::get<0>(other._iters);
     }
 
-    bool operator!=(Sentinel) const
+    bool operator>(const ZipIterator& other) const
     {
-        return !(*this == Sentinel{});
+        return std::get<0>(_iters) > std::get<0>(other._iters);
+    }
+
+    bool operator<=(const ZipIterator& other) const
+    {
+        return std::get<0>(_iters) <= std::get<0>(other._iters);
+    }
+
+    bool operator>=(const ZipIterator& other) const
+    {
+        return std::get<0>(_iters) >= std::get<0>(other._iters);
     }
 
 private:
+    template<std::size_t... kIndex>
+    bool equalAny(const ZipIterator& other, std::index_sequence<kIndex...>) const
+    {
+        return ((std::get<kIndex>(_iters) == std::get<kIndex>(other._iters)) || ...);
+    }
+
     std::tuple<Iterators...> _iters;
-    const mp::first_t<Iterators...> _end;
 };
 
 template<typename... Ranges>
-SentinelRange<ZipIterator<range_iterator_t<Ranges>...>> zip(Ranges&... ranges)
+ForwardRange<ZipIterator<range_iterator_t<Ranges>...>> zip(Ranges&... ranges)
 {
     using Iterator = ZipIterator<range_iterator_t<Ranges>...>;
 
-    return { Iterator(std::begin(ranges)..., std::end(mp::first_element(ranges...))) };
+    if constexpr (std::is_same_v<typename Iterator::iterator_category, std::random_access_iterator_tag>)
+    {
+        auto& first = mp::first_element(ranges...);
+        auto size = std::end(first) - std::begin(first);
+
+        return { Iterator(std::begin(ranges)...), Iterator((std::begin(ranges) + size)...) };
+    }
+    else
+    {
+        return { Iterator(std::begin(ranges)...), Iterator(std::end(ranges)...) };
+    }
+}
+
+namespace detail
+{
+
+template<typename Iterator>
+void assertRandomAccess()
+{
+    static_assert(std::is_same_v<common_iterator_category_t<Iterator>, std::random_access_iterator_tag>);
+}
+
+struct ChunkBounds
+{
+    std::size_t size;
+    std::size_t chunk;
+
+    std::size_t count() const
+    {
+        return (size + chunk - 1) / chunk;
+    }
+
+    std::pair<std::size_t, std::size_t> operator()(std::size_t index) const
+    {
+        std::size_t begin = std::min(size, index * chunk);
+        return { begin, std::min(size, begin + chunk) };
+    }
+};
+
+struct WindowBounds
+{
+    std::size_t size;
+    std::size_t window;
+
+    std::size_t count() const
+    {
+        return size >= window ? size - window + 1 : 0;
+    }
+
+    std::pair<std::size_t, std::size_t> operator()(std::size_t index) const
+    {
+        return { index, index + window };
+    }
+};
+
+struct BatchBounds
+{
+    std::size_t size;
+    std::size_t batches;
+
+    std::size_t count() const
+    {
+        return batches;
+    }
+
+    std::pair<std::size_t, std::size_t> operator()(std::size_t index) const
+    {
+        return { index * size / batches, (index + 1) * size / batches };
+    }
+};
+
+}  // namespace detail
+
+template<typename Iterator, typename Bounds>
+class SubrangeIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = BidirectionalRange<Iterator>;
+    using reference         = value_type;
+    using pointer           = void;
+
+    SubrangeIterator() = default;
+
+    SubrangeIterator(Iterator begin, Bounds bounds, difference_type index)
+        : _begin(begin), _bounds(bounds), _index(index) {}
+
+    reference operator*() const
+    {
+        auto [begin, end] = _bounds(static_cast<std::size_t>(_index));
+
+        return { _begin + begin, _begin + end };
+    }
+
+    reference operator[](difference_type offset) const
+    {
+        return *(*this + offset);
+    }
+
+    SubrangeIterator& operator++()
+    {
+        _index++;
+        return *this;
+    }
+
+    SubrangeIterator operator++(int)
+    {
+        SubrangeIterator iter(*this);
+        ++*this;
+        return iter;
+    }
+
+    SubrangeIterator& operator--()
+    {
+        _index--;
+        return *this;
+    }
+
+    SubrangeIterator operator--(int)
+    {
+        SubrangeIterator iter(*this);
+        --*this;
+        return iter;
+    }
+
+    SubrangeIterator& operator+=(difference_type offset)
+    {
+        _index += offset;
+        return *this;
+    }
+
+    SubrangeIterator& operator-=(difference_type offset)
+    {
+        _index -= offset;
+        return *this;
+    }
+
+    SubrangeIterator operator+(difference_type offset) const
+    {
+        return SubrangeIterator(*this) += offset;
+    }
+
+    SubrangeIterator operator-(difference_type offset) const
+    {
+        return SubrangeIterator(*this) -= offset;
+    }
+
+    friend SubrangeIterator operator+(difference_type offset, const SubrangeIterator& iter)
+    {
+        return iter + offset;
+    }
+
+    difference_type operator-(const SubrangeIterator& other) const
+    {
+        return _index - other._index;
+    }
+
+    bool operator==(const SubrangeIterator& other) const
+    {
+        return _index == other._index;
+    }
+
+    bool operator!=(const SubrangeIterator& other) const
+    {
+        return _index != other._index;
+    }
+
+    bool operator<(const SubrangeIterator& other) const
+    {
+        return _index < other._index;
+    }
+
+    bool operator>(const SubrangeIterator& other) const
+    {
+        return _index > other._index;
+    }
+
+    bool operator<=(const SubrangeIterator& other) const
+    {
+        return _index <= other._index;
+    }
+
+    bool operator>=(const SubrangeIterator& other) const
+    {
+        return _index >= other._index;
+    }
+
+private:
+    Iterator _begin;
+    Bounds _bounds{};
+    difference_type _index = 0;
+};
+
+namespace detail
+{
+
+template<typename Range, typename Bounds>
+ForwardRange<SubrangeIterator<range_iterator_t<Range>, Bounds>> subranges(Range& range, std::size_t parameter)
+{
+    using Iterator = SubrangeIterator<range_iterator_t<Range>, Bounds>;
+
+    assertRandomAccess<range_iterator_t<Range>>();
+
+    auto begin = std::begin(range);
+
+    Bounds bounds{ static_cast<std::size_t>(std::distance(begin, std::end(range))), parameter };
+
+    return { Iterator(begin, bounds, 0), Iterator(begin, bounds, static_cast<std::ptrdiff_t>(bounds.count())) };
+}
+
+}  // namespace detail
+
+template<typename Range>
+ForwardRange<SubrangeIterator<range_iterator_t<Range>, detail::ChunkBounds>> chunked(Range& range, std::size_t size)
+{
+    SHELL_ASSERT(size > 0);
+
+    return detail::subranges<Range, detail::ChunkBounds>(range, size);
+}
+
+template<typename Range>
+ForwardRange<SubrangeIterator<range_iterator_t<Range>, detail::WindowBounds>> windows(Range& range, std::size_t size)
+{
+    SHELL_ASSERT(size > 0);
+
+    return detail::subranges<Range, detail::WindowBounds>(range, size);
+}
+
+template<typename Range>
+ForwardRange<SubrangeIterator<range_iterator_t<Range>, detail::BatchBounds>> batched(Range& range, std::size_t count)
+{
+    SHELL_ASSERT(count > 0);
+
+    return detail::subranges<Range, detail::BatchBounds>(range, count);
+}
+
+template<typename Iterator>
+class StrideIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = typename std::iterator_traits<Iterator>::value_type;
+    using reference         = typename std::iterator_traits<Iterator>::reference;
+    using pointer           = typename std::iterator_traits<Iterator>::pointer;
+
+    StrideIterator() = default;
+
+    StrideIterator(Iterator begin, difference_type stride, difference_type index)
+        : _begin(begin), _stride(stride), _index(index) {}
+
+    reference operator*() const
+    {
+        return _begin[_index * _stride];
+    }
+
+    reference operator[](difference_type offset) const
+    {
+        return _begin[(_index + offset) * _stride];
+    }
+
+    StrideIterator& operator++()
+    {
+        _index++;
+        return *this;
+    }
+
+    StrideIterator operator++(int)
+    {
+        StrideIterator iter(*this);
+        ++*this;
+        return iter;
+    }
+
+    StrideIterator& operator--()
+    {
+        _index--;
+        return *this;
+    }
+
+    StrideIterator operator--(int)
+    {
+        StrideIterator iter(*this);
+        --*this;
+        return iter;
+    }
+
+    StrideIterator& operator+=(difference_type offset)
+    {
+        _index += offset;
+        return *this;
+    }
+
+    StrideIterator& operator-=(difference_type offset)
+    {
+        _index -= offset;
+        return *this;
+    }
+
+    StrideIterator operator+(difference_type offset) const
+    {
+        return StrideIterator(*this) += offset;
+    }
+
+    StrideIterator operator-(difference_type offset) const
+    {
+        return StrideIterator(*this) -= offset;
+    }
+
+    friend StrideIterator operator+(difference_type offset, const StrideIterator& iter)
+    {
+        return iter + offset;
+    }
+
+    difference_type operator-(const StrideIterator& other) const
+    {
+        return _index - other._index;
+    }
+
+    bool operator==(const StrideIterator& other) const
+    {
+        return _index == other._index;
+    }
+
+    bool operator!=(const StrideIterator& other) const
+    {
+        return _index != other._index;
+    }
+
+    bool operator<(const StrideIterator& other) const
+    {
+        return _index < other._index;
+    }
+
+    bool operator>(const StrideIterator& other) const
+    {
+        return _index > other._index;
+    }
+
+    bool operator<=(const StrideIterator& other) const
+    {
+        return _index <= other._index;
+    }
+
+    bool operator>=(const StrideIterator& other) const
+    {
+        return _index >= other._index;
+    }
+
+private:
+    Iterator _begin;
+    difference_type _stride = 1;
+    difference_type _index = 0;
+};
+
+template<typename Range>
+ForwardRange<StrideIterator<range_iterator_t<Range>>> strided(Range& range, std::size_t stride)
+{
+    using Iterator = StrideIterator<range_iterator_t<Range>>;
+
+    detail::assertRandomAccess<range_iterator_t<Range>>();
+    SHELL_ASSERT(stride > 0);
+
+    auto begin = std::begin(range);
+    auto size  = std::distance(begin, std::end(range));
+    auto step  = static_cast<std::ptrdiff_t>(stride);
+
+    return { Iterator(begin, step, 0), Iterator(begin, step, (size + step - 1) / step) };
 }
 
 template<typename Range> 
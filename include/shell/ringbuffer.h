@@ -1,78 +1,344 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <new>
+#include <numeric>
+#include <thread>
 
+#include <shell/bit.h>
+#include <shell/constants.h>
 #include <shell/macros.h>
+#include <shell/predef.h>
 #include <shell/ranges.h>
 
+#if SHELL_OS_LINUX
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 namespace shell
 {
 
+namespace detail
+{
+
+template<std::size_t kSize>
+struct RingIndex
+{
+    static constexpr bool kPowTwo = bit::isPowTwo(kSize);
+
+    static constexpr std::size_t wrap(std::size_t index)
+    {
+        if constexpr (kPowTwo)
+            return index & (kSize - 1);
+        else
+            return index < kSize ? index : index - kSize;
+    }
+
+    static constexpr std::size_t advance(std::size_t index, std::size_t amount)
+    {
+        if constexpr (kPowTwo)
+            return index + amount;
+        else
+            return wrap(index + amount);
+    }
+};
+
+class Backoff
+{
+public:
+    void wait()
+    {
+        if (_spins < kSpinLimit)
+        {
+            for (uint i = 0; i < _spins; ++i)
+                pause();
+
+            _spins *= 2;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr uint kSpinLimit = 64;
+
+    static void pause()
+    {
+        #if SHELL_ARCH_X86 && !SHELL_CC_EMSCRIPTEN
+        _mm_pause();
+        #endif
+    }
+
+    uint _spins = 1;
+};
+
+class MirroredMemory
+{
+public:
+    MirroredMemory() = default;
+
+    MirroredMemory(std::size_t size, bool mirror = true)
+        : _size(size)
+    {
+        SHELL_ASSERT(size % granularity() == 0);
+
+        #if SHELL_OS_LINUX
+        int fd = mirror ? memfd_create("shell::MirroredMemory", MFD_CLOEXEC) : -1;
+        if (fd != -1)
+        {
+            if (ftruncate(fd, size) == 0)
+                map(fd);
+
+            close(fd);
+        }
+        #else
+        SHELL_UNUSED(mirror);
+        #endif
+
+        if (!_mirrored)
+            _data = static_cast<u8*>(::operator new(2 * size));
+    }
+
+    MirroredMemory(MirroredMemory&& other)
+    {
+        swap(other);
+    }
+
+    MirroredMemory(const MirroredMemory&) = delete;
+
+    ~MirroredMemory()
+    {
+        if (!_data)
+            return;
+
+        #if SHELL_OS_LINUX
+        if (_mirrored)
+        {
+            munmap(_data, 2 * _size);
+            return;
+        }
+        #endif
+
+        ::operator delete(_data);
+    }
+
+    MirroredMemory& operator=(MirroredMemory&& other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    MirroredMemory& operator=(const MirroredMemory&) = delete;
+
+    static std::size_t granularity()
+    {
+        #if SHELL_OS_LINUX
+        static const std::size_t kPageSize = sysconf(_SC_PAGESIZE);
+        return kPageSize;
+        #else
+        return 1;
+        #endif
+    }
+
+    u8* data() const
+    {
+        return _data;
+    }
+
+    bool isMirrored() const
+    {
+        return _mirrored;
+    }
+
+private:
+    void swap(MirroredMemory& other)
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_mirrored, other._mirrored);
+    }
+
+    #if SHELL_OS_LINUX
+    void map(int fd)
+    {
+        void* base = mmap(nullptr, 2 * _size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+            return;
+
+        u8* data = static_cast<u8*>(base);
+
+        if (mmap(data, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                || mmap(data + _size, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            munmap(base, 2 * _size);
+            return;
+        }
+
+        _data = data;
+        _mirrored = true;
+    }
+    #endif
+
+    u8* _data = nullptr;
+    std::size_t _size = 0;
+    bool _mirrored = false;
+};
+
+}  // namespace detail
+
 template<typename T, std::size_t kSize>
 class RingBufferIterator
 {
 public:
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
     using difference_type   = std::ptrdiff_t;
-    using value_type        = T;
-    using reference         = value_type&;
-    using pointer           = value_type*;
+    using value_type        = std::remove_const_t<T>;
+    using reference         = T&;
+    using pointer           = T*;
 
-    RingBufferIterator(T* data, std::size_t index, std::size_t size)
-        : _data(data), _index(index), _size(size) {}
+    RingBufferIterator() = default;
 
-    reference operator*()
+    RingBufferIterator(T* data, std::size_t index, std::size_t offset)
+        : _data(data), _index(index), _offset(offset) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    RingBufferIterator(const RingBufferIterator<U, kSize>& other)
+        : _data(other._data), _index(other._index), _offset(other._offset) {}
+
+    reference operator*() const
+    {
+        return _data[Index::wrap(_index + _offset)];
+    }
+
+    pointer operator->() const
+    {
+        return &**this;
+    }
+
+    reference operator[](difference_type offset) const
     {
-        return _data[_index];
+        return *(*this + offset);
     }
 
     RingBufferIterator& operator++()
     {
-        _size--;
-        _index = (_index + 1) % kSize;
-        
+        _offset++;
         return *this;
     }
 
+    RingBufferIterator operator++(int)
+    {
+        RingBufferIterator iter(*this);
+        ++*this;
+        return iter;
+    }
+
+    RingBufferIterator& operator--()
+    {
+        _offset--;
+        return *this;
+    }
+
+    RingBufferIterator operator--(int)
+    {
+        RingBufferIterator iter(*this);
+        --*this;
+        return iter;
+    }
+
+    RingBufferIterator& operator+=(difference_type offset)
+    {
+        _offset += offset;
+        return *this;
+    }
+
+    RingBufferIterator& operator-=(difference_type offset)
+    {
+        _offset -= offset;
+        return *this;
+    }
+
+    RingBufferIterator operator+(difference_type offset) const
+    {
+        return RingBufferIterator(*this) += offset;
+    }
+
+    RingBufferIterator operator-(difference_type offset) const
+    {
+        return RingBufferIterator(*this) -= offset;
+    }
+
+    friend RingBufferIterator operator+(difference_type offset, const RingBufferIterator& iter)
+    {
+        return iter + offset;
+    }
+
+    difference_type operator-(const RingBufferIterator& other) const
+    {
+        return static_cast<difference_type>(_offset - other._offset);
+    }
+
     bool operator==(const RingBufferIterator& other) const
     {
-        return _data == other._data && _index == other._index && _size == other._size;
+        return _offset == other._offset;
     }
 
     bool operator!=(const RingBufferIterator& other) const
     {
-        return !(*this == other);
+        return _offset != other._offset;
+    }
+
+    bool operator<(const RingBufferIterator& other) const
+    {
+        return _offset < other._offset;
     }
 
-    bool operator==(Sentinel) const
+    bool operator>(const RingBufferIterator& other) const
     {
-        return _size == 0;
+        return _offset > other._offset;
     }
 
-    bool operator!=(Sentinel) const
+    bool operator<=(const RingBufferIterator& other) const
     {
-        return !(*this == Sentinel{});
+        return _offset <= other._offset;
+    }
+
+    bool operator>=(const RingBufferIterator& other) const
+    {
+        return _offset >= other._offset;
     }
 
 private:
-    T* _data;
-    std::size_t _index;
-    std::size_t _size;
+    template<typename, std::size_t>
+    friend class RingBufferIterator;
+
+    using Index = detail::RingIndex<kSize>;
+
+    T* _data = nullptr;
+    std::size_t _index = 0;
+    std::size_t _offset = 0;
 };
 
 template<typename T, std::size_t kSize>
 class RingBuffer
 {
 public:
-    using value_type      = T;
-    using reference       = value_type&;
-    using const_reference = const reference;
-    using pointer         = value_type*;
-    using const_pointer   = const pointer;
-    using iterator        = RingBufferIterator<T, kSize>;
-    using const_iterator  = const iterator;
-    using sentinel        = Sentinel;
-    using const_sentinel  = const sentinel;
+    static_assert(kSize > 0);
+
+    using value_type             = T;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = RingBufferIterator<T, kSize>;
+    using const_iterator         = RingBufferIterator<const T, kSize>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     RingBuffer() = default;
     RingBuffer(const RingBuffer<T, kSize>&) = default;
@@ -89,13 +355,13 @@ class RingBuffer
     reference operator[](std::size_t index)
     {
         SHELL_ASSERT(index < _length);
-        return _data[(_rindex + index) % kSize];
+        return _data[Index::wrap(_rindex + index)];
     }
 
     const_reference operator[](std::size_t index) const
     {
         SHELL_ASSERT(index < _length);
-        return _data[(_rindex + index) % kSize];
+        return _data[Index::wrap(_rindex + index)];
     }
 
     constexpr std::size_t capacity() const
@@ -125,37 +391,69 @@ class RingBuffer
         _windex = 0;
     }
 
+    pointer linearize()
+    {
+        if (std::size_t index = Index::wrap(_rindex))
+            std::rotate(_data.begin(), _data.begin() + index, _data.end());
+
+        _rindex = 0;
+        _windex = Index::advance(0, _length);
+
+        return _data.data();
+    }
+
     value_type read()
     {
         SHELL_ASSERT(_length > 0);
 
-        const T& value = _data[_rindex];
+        value_type value = std::move(_data[Index::wrap(_rindex)]);
         _length--;
-        _rindex = (_rindex + 1) % kSize;
+        _rindex = Index::advance(_rindex, 1);
 
         return value;
     }
 
-    void write(const T& value)
+    void read(T* data, std::size_t size)
     {
-        if (_length == kSize)
-            _rindex = (_rindex + 1) % kSize;
-        else
-            _length++;
+        SHELL_ASSERT(size <= _length);
+
+        std::size_t index = Index::wrap(_rindex);
+        std::size_t first = std::min(size, kSize - index);
 
-        _data[_windex] = value;
-        _windex = (_windex + 1) % kSize;
+        std::move(_data.begin() + index, _data.begin() + index + first, data);
+        std::move(_data.begin(), _data.begin() + (size - first), data + first);
+
+        _length -= size;
+        _rindex = Index::advance(_rindex, size);
+    }
+
+    void write(const T& value)
+    {
+        _data[Index::wrap(_windex)] = value;
+        commit(1);
     }
 
     void write(T&& value)
     {
-        if (_length == kSize)
-            _rindex = (_rindex + 1) % kSize;
-        else
-            _length++;
+        _data[Index::wrap(_windex)] = std::move(value);
+        commit(1);
+    }
+
+    void write(const T* data, std::size_t size)
+    {
+        if (size > kSize)
+        {
+            data += size - kSize;
+            size = kSize;
+        }
+
+        std::size_t index = Index::wrap(_windex);
+        std::size_t first = std::min(size, kSize - index);
 
-        _data[_windex] = std::move(value);
-        _windex = (_windex + 1) % kSize;
+        std::copy(data, data + first, _data.begin() + index);
+        std::copy(data + first, data + size, _data.begin());
+
+        commit(size);
     }
 
     reference front()
@@ -178,13 +476,562 @@ class RingBuffer
         return (*this)[_length - 1];
     }
 
-    SHELL_SENTINEL_ITERATORS(SHELL_ARG(data(), _rindex, _length))
+    SHELL_FORWARD_ITERATORS(SHELL_ARG(_data.data(), _rindex, 0), SHELL_ARG(_data.data(), _rindex, _length))
+    SHELL_REVERSE_ITERATORS(end(), begin())
 
 private:
+    using Index = detail::RingIndex<kSize>;
+
+    void commit(std::size_t size)
+    {
+        _windex = Index::advance(_windex, size);
+        _length = _length + size;
+
+        if (_length > kSize)
+        {
+            _rindex = Index::advance(_rindex, _length - kSize);
+            _length = kSize;
+        }
+    }
+
     std::size_t _length = 0;
     std::size_t _rindex = 0;
     std::size_t _windex = 0;
     std::array<T, kSize> _data = {};
 };
 
+template<typename T, std::size_t kSize>
+class SpscRingBuffer
+{
+public:
+    static_assert(bit::isPowTwo(kSize));
+
+    using value_type = T;
+
+    SpscRingBuffer() = default;
+    SpscRingBuffer(const SpscRingBuffer<T, kSize>&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer<T, kSize>&) = delete;
+
+    static constexpr std::size_t capacity()
+    {
+        return kSize;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t head = _head.load(std::memory_order_acquire);
+        std::size_t tail = _tail.load(std::memory_order_acquire);
+
+        return tail - head;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    bool try_push(const T& value)
+    {
+        return pushValue(value);
+    }
+
+    bool try_push(T&& value)
+    {
+        return pushValue(std::move(value));
+    }
+
+    std::size_t try_push(const T* data, std::size_t size)
+    {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+        if (kSize - (tail - _head_cached) < size)
+            _head_cached = _head.load(std::memory_order_acquire);
+
+        size = std::min(size, kSize - (tail - _head_cached));
+
+        std::size_t index = tail & kMask;
+        std::size_t first = std::min(size, kSize - index);
+
+        std::copy(data, data + first, _data.begin() + index);
+        std::copy(data + first, data + size, _data.begin());
+
+        _tail.store(tail + size, std::memory_order_release);
+
+        return size;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t head = _head.load(std::memory_order_relaxed);
+
+        if (head == _tail_cached)
+        {
+            _tail_cached = _tail.load(std::memory_order_acquire);
+
+            if (head == _tail_cached)
+                return false;
+        }
+
+        value = std::move(_data[head & kMask]);
+        _head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    std::size_t try_pop(T* data, std::size_t size)
+    {
+        std::size_t head = _head.load(std::memory_order_relaxed);
+
+        if (_tail_cached - head < size)
+            _tail_cached = _tail.load(std::memory_order_acquire);
+
+        size = std::min(size, _tail_cached - head);
+
+        std::size_t index = head & kMask;
+        std::size_t first = std::min(size, kSize - index);
+
+        std::move(_data.begin() + index, _data.begin() + index + first, data);
+        std::move(_data.begin(), _data.begin() + (size - first), data + first);
+
+        _head.store(head + size, std::memory_order_release);
+
+        return size;
+    }
+
+    void push(const T& value)
+    {
+        detail::Backoff backoff;
+        while (!try_push(value))
+            backoff.wait();
+    }
+
+    void push(T&& value)
+    {
+        detail::Backoff backoff;
+        while (!try_push(std::move(value)))
+            backoff.wait();
+    }
+
+    value_type pop()
+    {
+        value_type value;
+
+        detail::Backoff backoff;
+        while (!try_pop(value))
+            backoff.wait();
+
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kMask = kSize - 1;
+
+    template<typename U>
+    bool pushValue(U&& value)
+    {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail - _head_cached == kSize)
+        {
+            _head_cached = _head.load(std::memory_order_acquire);
+
+            if (tail - _head_cached == kSize)
+                return false;
+        }
+
+        _data[tail & kMask] = std::forward<U>(value);
+        _tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> _head = 0;
+    std::size_t _tail_cached = 0;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> _tail = 0;
+    std::size_t _head_cached = 0;
+
+    alignas(kCacheLineSize) std::array<T, kSize> _data = {};
+};
+
+template<typename T, std::size_t kSize>
+class MpmcRingBuffer
+{
+public:
+    static_assert(kSize > 1 && bit::isPowTwo(kSize));
+
+    using value_type = T;
+
+    MpmcRingBuffer()
+    {
+        for (std::size_t i = 0; i < kSize; ++i)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer<T, kSize>&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer<T, kSize>&) = delete;
+
+    static constexpr std::size_t capacity()
+    {
+        return kSize;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t head = _head.load(std::memory_order_acquire);
+        std::size_t tail = _tail.load(std::memory_order_acquire);
+
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    bool try_push(const T& value)
+    {
+        return pushValue(value);
+    }
+
+    bool try_push(T&& value)
+    {
+        return pushValue(std::move(value));
+    }
+
+    std::size_t try_push(const T* data, std::size_t size)
+    {
+        std::size_t pushed = 0;
+        while (pushed < size && try_push(data[pushed]))
+            pushed++;
+
+        return pushed;
+    }
+
+    bool try_pop(T& value)
+    {
+        std::size_t head = _head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = _cells[head & kMask];
+
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - (head + 1));
+
+            if (difference == 0)
+            {
+                if (_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.sequence.store(head + kSize, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                head = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t try_pop(T* data, std::size_t size)
+    {
+        std::size_t popped = 0;
+        while (popped < size && try_pop(data[popped]))
+            popped++;
+
+        return popped;
+    }
+
+    void push(const T& value)
+    {
+        detail::Backoff backoff;
+        while (!try_push(value))
+            backoff.wait();
+    }
+
+    void push(T&& value)
+    {
+        detail::Backoff backoff;
+        while (!try_push(std::move(value)))
+            backoff.wait();
+    }
+
+    value_type pop()
+    {
+        value_type value;
+
+        detail::Backoff backoff;
+        while (!try_pop(value))
+            backoff.wait();
+
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kMask = kSize - 1;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    template<typename U>
+    bool pushValue(U&& value)
+    {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Cell& cell = _cells[tail & kMask];
+
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - tail);
+
+            if (difference == 0)
+            {
+                if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::forward<U>(value);
+                    cell.sequence.store(tail + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                tail = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> _head = 0;
+    alignas(kCacheLineSize) std::atomic<std::size_t> _tail = 0;
+    alignas(kCacheLineSize) std::array<Cell, kSize> _cells;
+};
+
+template<typename T>
+class DynamicRingBuffer
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    using value_type             = T;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = pointer;
+    using const_iterator         = const_pointer;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Without mirror, or where mapping fails, the data is kept twice in a
+    // plain allocation and copied between both halves.
+    explicit DynamicRingBuffer(std::size_t capacity, bool mirror = true)
+    {
+        SHELL_ASSERT(capacity > 0);
+
+        std::size_t granularity = std::lcm(detail::MirroredMemory::granularity(), sizeof(T));
+        std::size_t size = (capacity * sizeof(T) + granularity - 1) / granularity * granularity;
+
+        _memory = detail::MirroredMemory(size, mirror);
+        _data = reinterpret_cast<T*>(_memory.data());
+        _capacity = size / sizeof(T);
+    }
+
+    DynamicRingBuffer(DynamicRingBuffer<T>&& other)
+    {
+        swap(other);
+    }
+
+    DynamicRingBuffer& operator=(DynamicRingBuffer<T>&& other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    reference operator[](std::size_t index)
+    {
+        SHELL_ASSERT(index < _length);
+        return _data[_rindex + index];
+    }
+
+    const_reference operator[](std::size_t index) const
+    {
+        SHELL_ASSERT(index < _length);
+        return _data[_rindex + index];
+    }
+
+    std::size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    std::size_t size() const
+    {
+        return _length;
+    }
+
+    bool empty() const
+    {
+        return _length == 0;
+    }
+
+    bool isMirrored() const
+    {
+        return _memory.isMirrored();
+    }
+
+    pointer data()
+    {
+        return _data + _rindex;
+    }
+
+    const_pointer data() const
+    {
+        return _data + _rindex;
+    }
+
+    void clear()
+    {
+        _length = 0;
+        _rindex = 0;
+    }
+
+    value_type read()
+    {
+        SHELL_ASSERT(_length > 0);
+
+        value_type value = _data[_rindex];
+        consume(1);
+
+        return value;
+    }
+
+    void read(T* data, std::size_t size)
+    {
+        SHELL_ASSERT(size <= _length);
+
+        std::copy(this->data(), this->data() + size, data);
+        consume(size);
+    }
+
+    void consume(std::size_t size)
+    {
+        SHELL_ASSERT(size <= _length);
+
+        _length -= size;
+        _rindex += size;
+
+        if (_rindex >= _capacity)
+        {
+            _rindex -= _capacity;
+
+            // The remaining elements may have been modified through mutable
+            // access in the second half, which the first half now refers to.
+            if (!_memory.isMirrored())
+                std::copy(_data + _capacity + _rindex, _data + _capacity + _rindex + _length, _data + _rindex);
+        }
+    }
+
+    void write(const T& value)
+    {
+        write(&value, 1);
+    }
+
+    void write(const T* data, std::size_t size)
+    {
+        if (size > _capacity)
+        {
+            data += size - _capacity;
+            size = _capacity;
+        }
+
+        std::copy(data, data + size, prepare());
+        commit(size);
+    }
+
+    pointer prepare()
+    {
+        return _data + wrap(_rindex + _length);
+    }
+
+    void commit(std::size_t size)
+    {
+        SHELL_ASSERT(size <= _capacity);
+
+        std::size_t windex = wrap(_rindex + _length);
+
+        if (!_memory.isMirrored())
+        {
+            std::size_t first = std::min(size, _capacity - windex);
+
+            std::copy(_data + windex, _data + windex + first, _data + windex + _capacity);
+            std::copy(_data + _capacity, _data + _capacity + (size - first), _data);
+        }
+
+        if (_length + size > _capacity)
+            consume(_length + size - _capacity);
+
+        _length += size;
+    }
+
+    reference front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0];
+    }
+
+    reference back()
+    {
+        return (*this)[_length - 1];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[_length - 1];
+    }
+
+    SHELL_FORWARD_ITERATORS(_data + _rindex, _data + _rindex + _length)
+    SHELL_REVERSE_ITERATORS(_data + _rindex + _length, _data + _rindex)
+
+private:
+    std::size_t wrap(std::size_t index) const
+    {
+        return index < _capacity ? index : index - _capacity;
+    }
+
+    void swap(DynamicRingBuffer<T>& other)
+    {
+        std::swap(_memory, other._memory);
+        std::swap(_data, other._data);
+        std::swap(_capacity, other._capacity);
+        std::swap(_length, other._length);
+        std::swap(_rindex, other._rindex);
+    }
+
+    detail::MirroredMemory _memory;
+    T* _data = nullptr;
+    std::size_t _capacity = 0;
+    std::size_t _length = 0;
+    std::size_t _rindex = 0;
+};
+
 }  // namespace shell
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <shell/constants.h>
+#include <shell/macros.h>
+#include <shell/mp.h>
+#include <shell/ranges.h>
+
+namespace shell
+{
+
+template<typename... Ts>
+class SoaVector
+{
+public:
+    static_assert(sizeof...(Ts) > 0);
+
+    static constexpr std::size_t kAlignment = kCacheLineSize;
+
+    using value_type             = std::tuple<Ts...>;
+    using reference              = std::tuple<Ts&...>;
+    using const_reference        = std::tuple<const Ts&...>;
+    using iterator               = ZipIterator<Ts*...>;
+    using const_iterator         = ZipIterator<const Ts*...>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template<std::size_t kIndex>
+    using column_type = mp::nth_t<kIndex, Ts...>;
+
+    SoaVector() = default;
+
+    SoaVector(const SoaVector<Ts...>& other)
+    {
+        reserve(other._size);
+        for (std::size_t i = 0; i < other._size; ++i)
+            push_back(other[i]);
+    }
+
+    SoaVector(SoaVector<Ts...>&& other) noexcept
+    {
+        swap(other);
+    }
+
+    ~SoaVector()
+    {
+        clear();
+        deallocate(_columns, Indices{});
+    }
+
+    SoaVector& operator=(const SoaVector<Ts...>& other)
+    {
+        if (this != &other)
+        {
+            SoaVector<Ts...> copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector<Ts...>&& other) noexcept
+    {
+        SoaVector<Ts...> moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    reference operator[](std::size_t index)
+    {
+        SHELL_ASSERT(index < _size);
+
+        return begin()[index];
+    }
+
+    const_reference operator[](std::size_t index) const
+    {
+        SHELL_ASSERT(index < _size);
+
+        return begin()[index];
+    }
+
+    template<std::size_t kIndex>
+    column_type<kIndex>* data()
+    {
+        return std::get<kIndex>(_columns);
+    }
+
+    template<std::size_t kIndex>
+    const column_type<kIndex>* data() const
+    {
+        return std::get<kIndex>(_columns);
+    }
+
+    template<std::size_t kIndex>
+    BidirectionalRange<column_type<kIndex>*> column()
+    {
+        return { data<kIndex>(), data<kIndex>() + _size };
+    }
+
+    template<std::size_t kIndex>
+    BidirectionalRange<const column_type<kIndex>*> column() const
+    {
+        return { data<kIndex>(), data<kIndex>() + _size };
+    }
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    std::size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > _capacity)
+            reallocate(capacity);
+    }
+
+    void resize(std::size_t size)
+    {
+        reserve(size);
+        while (_size < size)
+            emplace_back();
+        while (_size > size)
+            pop_back();
+    }
+
+    void clear()
+    {
+        while (_size > 0)
+            pop_back();
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == 0 || sizeof...(Args) == sizeof...(Ts));
+
+        auto element = std::forward_as_tuple(std::forward<Args>(args)...);
+        if (_size == _capacity)
+            reallocate(_capacity > 0 ? 2 * _capacity : 8, &element);
+        else
+            construct(_columns, _size, element);
+
+        return (*this)[_size++];
+    }
+
+    void push_back(const value_type& value)
+    {
+        std::apply([this](const Ts&... values) { emplace_back(values...); }, value);
+    }
+
+    void push_back(value_type&& value)
+    {
+        std::apply([this](Ts&... values) { emplace_back(std::move(values)...); }, value);
+    }
+
+    template<typename... Us, typename = std::enable_if_t<sizeof...(Us) == sizeof...(Ts)>>
+    void push_back(const std::tuple<Us...>& value)
+    {
+        std::apply([this](const Us&... values) { emplace_back(values...); }, value);
+    }
+
+    void pop_back()
+    {
+        SHELL_ASSERT(_size > 0);
+
+        _size--;
+        destroy(_size, Indices{});
+    }
+
+    void swap(SoaVector<Ts...>& other) noexcept
+    {
+        std::swap(_columns, other._columns);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    iterator begin()
+    {
+        return std::make_from_tuple<iterator>(_columns);
+    }
+
+    iterator end()
+    {
+        return begin() + static_cast<std::ptrdiff_t>(_size);
+    }
+
+    const_iterator begin() const
+    {
+        return std::make_from_tuple<const_iterator>(_columns);
+    }
+
+    const_iterator end() const
+    {
+        return begin() + static_cast<std::ptrdiff_t>(_size);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    SHELL_REVERSE_ITERATORS(end(), begin())
+
+private:
+    using Indices = std::index_sequence_for<Ts...>;
+    using Columns = std::tuple<Ts*...>;
+
+    template<typename T>
+    static T* allocate(std::size_t size)
+    {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    template<typename T>
+    static void deallocate(T* data)
+    {
+        if (data)
+            ::operator delete(data, std::align_val_t(kAlignment));
+    }
+
+    template<std::size_t... kIndex>
+    static void deallocate(Columns& columns, std::index_sequence<kIndex...>)
+    {
+        (deallocate(std::get<kIndex>(columns)), ...);
+    }
+
+    template<std::size_t... kIndex>
+    static void allocate(Columns& columns, std::size_t capacity, std::index_sequence<kIndex...>)
+    {
+        ((std::get<kIndex>(columns) = allocate<Ts>(capacity)), ...);
+    }
+
+    // Constructs the element at index in every column from args, or by
+    // default if args is empty. Destroys the columns already constructed
+    // if a constructor throws.
+    template<std::size_t kIndex = 0, typename... Args>
+    static void construct(const Columns& columns, std::size_t index, std::tuple<Args...>& args)
+    {
+        if constexpr (kIndex < sizeof...(Ts))
+        {
+            using T = column_type<kIndex>;
+
+            T* dst = std::get<kIndex>(columns) + index;
+            if constexpr (sizeof...(Args) == 0)
+                new (dst) T();
+            else
+                new (dst) T(std::forward<mp::nth_t<kIndex, Args...>>(std::get<kIndex>(args)));
+
+            try
+            {
+                construct<kIndex + 1>(columns, index, args);
+            }
+            catch (...)
+            {
+                std::destroy_at(dst);
+                throw;
+            }
+        }
+    }
+
+    template<std::size_t... kIndex>
+    static void destroy(const Columns& columns, std::size_t index, std::index_sequence<kIndex...>)
+    {
+        (std::destroy_at(std::get<kIndex>(columns) + index), ...);
+    }
+
+    template<std::size_t... kIndex>
+    void destroy(std::size_t index, std::index_sequence<kIndex...> indices)
+    {
+        destroy(_columns, index, indices);
+    }
+
+    // Moves the elements into columns, or copies them if moving may throw,
+    // so that the old columns stay intact if a constructor throws.
+    template<std::size_t kIndex = 0>
+    void relocate(const Columns& columns)
+    {
+        if constexpr (kIndex < sizeof...(Ts))
+        {
+            using T = column_type<kIndex>;
+
+            T* src = std::get<kIndex>(_columns);
+            T* dst = std::get<kIndex>(columns);
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                std::uninitialized_move_n(src, _size, dst);
+            else
+                std::uninitialized_copy_n(src, _size, dst);
+
+            try
+            {
+                relocate<kIndex + 1>(columns);
+            }
+            catch (...)
+            {
+                std::destroy_n(dst, _size);
+                throw;
+            }
+        }
+    }
+
+    // The new element is constructed before relocating because its
+    // arguments may refer to elements of this vector.
+    template<typename... Args>
+    void reallocate(std::size_t capacity, std::tuple<Args...>* element = nullptr)
+    {
+        Columns columns{};
+        try
+        {
+            allocate(columns, capacity, Indices{});
+            if (element)
+                construct(columns, _size, *element);
+
+            try
+            {
+                relocate(columns);
+            }
+            catch (...)
+            {
+                if (element)
+                    destroy(columns, _size, Indices{});
+                throw;
+            }
+        }
+        catch (...)
+        {
+            deallocate(columns, Indices{});
+            throw;
+        }
+
+        for (std::size_t i = 0; i < _size; ++i)
+            destroy(i, Indices{});
+        deallocate(_columns, Indices{});
+
+        _columns = columns;
+        _capacity = capacity;
+    }
+
+    Columns _columns{};
+    std::size_t _size = 0;
+    std::size_t _capacity = 0;
+};
+
+}  // namespace shell
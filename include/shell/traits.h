@@ -59,6 +59,17 @@ struct dereferenced
 template<typename T>
 using dereferenced_t = typename dereferenced<T>::type;
 
+template<typename... Iterators>
+struct common_iterator_category
+{
+    using type = std::common_type_t<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterators>::iterator_category...>;
+};
+
+template<typename... Iterators>
+using common_iterator_category_t = typename common_iterator_category<Iterators...>::type;
+
 template<typename Range, typename = void>
 struct range_traits
 {
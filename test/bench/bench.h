@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/macros.h>
+#include <shell/parse.h>
+#include <shell/predef.h>
+#include <shell/profile.h>
+
+#if SHELL_OS_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace bench
+{
+
+using namespace shell;
+
+struct Config
+{
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(20);
+    std::size_t warmup = 1;
+    std::size_t repetitions = 10;
+};
+
+struct Result
+{
+    std::string name;
+    u64 iterations = 0;
+    u64 bytes = 0;
+    double median = 0;
+    double mean = 0;
+    double min = 0;
+    double stddev = 0;
+    double cycles = 0;  // TSC reference cycles, not core clock cycles
+
+    double cyclesPerByte() const
+    {
+        return bytes > 0 ? cycles / static_cast<double>(bytes) : 0.0;
+    }
+
+    double gigabytesPerSecond() const
+    {
+        return bytes > 0 ? static_cast<double>(bytes) / median : 0.0;
+    }
+};
+
+namespace detail
+{
+
+SHELL_NO_INLINE inline void use(const void*) {}
+
+}  // namespace detail
+
+template<typename T>
+SHELL_INLINE void doNotOptimize(const T& value)
+{
+    #if SHELL_CC_MSVC
+    detail::use(&value);
+    #else
+    asm volatile("" : : "r,m"(value) : "memory");
+    #endif
+}
+
+class State
+{
+public:
+    explicit State(const Config& config)
+        : _config(config) {}
+
+    void setBytes(u64 bytes)
+    {
+        _bytes = bytes;
+    }
+
+    // Times func() per iteration.
+    template<typename Function>
+    void run(Function func)
+    {
+        runBatch([&func](u64 iterations)
+        {
+            for (u64 i = 0; i < iterations; ++i)
+                func();
+        });
+    }
+
+    // Times func(iterations) and divides by the iteration count, for
+    // benchmarks that need setup around the loop, e.g. threads.
+    template<typename Function>
+    void runBatch(Function func)
+    {
+        u64 iterations = 1;
+        while (true)
+        {
+            double elapsed = measure(func, iterations).first;
+            if (elapsed >= static_cast<double>(_config.min_time.count()) || iterations >= (u64(1) << 40))
+                break;
+
+            double factor = 1.2 * static_cast<double>(_config.min_time.count()) / std::max(elapsed, 1.0);
+            iterations = static_cast<u64>(static_cast<double>(iterations) * std::clamp(factor, 2.0, 100.0));
+        }
+
+        for (std::size_t i = 0; i < _config.warmup; ++i)
+            measure(func, iterations);
+
+        _samples.clear();
+        _cycles.clear();
+        for (std::size_t i = 0; i < _config.repetitions; ++i)
+        {
+            auto [elapsed, ticks] = measure(func, iterations);
+            _samples.push_back(elapsed / static_cast<double>(iterations));
+            _cycles.push_back(ticks / static_cast<double>(iterations));
+        }
+        _iterations = iterations;
+    }
+
+    std::optional<Result> result(std::string name) const
+    {
+        if (_samples.empty())
+            return std::nullopt;
+
+        Result result;
+        result.name = std::move(name);
+        result.iterations = _iterations;
+        result.bytes = _bytes;
+        result.median = median(_samples);
+        result.min = *std::min_element(_samples.begin(), _samples.end());
+        result.cycles = median(_cycles);
+
+        for (double sample : _samples)
+            result.mean += sample / static_cast<double>(_samples.size());
+
+        for (double sample : _samples)
+            result.stddev += (sample - result.mean) * (sample - result.mean);
+        result.stddev = std::sqrt(result.stddev / static_cast<double>(_samples.size()));
+
+        return result;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Function>
+    static std::pair<double, double> measure(Function& func, u64 iterations)
+    {
+        auto begin = Clock::now();
+        u64 ticks = shell::detail::ticks();
+        func(iterations);
+        ticks = shell::detail::ticks() - ticks;
+        auto end = Clock::now();
+
+        return { std::chrono::duration<double, std::nano>(end - begin).count(), static_cast<double>(ticks) };
+    }
+
+    static double median(std::vector<double> values)
+    {
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+
+    Config _config;
+    u64 _bytes = 0;
+    u64 _iterations = 0;
+    std::vector<double> _samples;
+    std::vector<double> _cycles;
+};
+
+struct Benchmark
+{
+    std::string name;
+    std::function<void(State&)> func;
+};
+
+inline std::vector<Benchmark>& benchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+inline bool add(std::string name, std::function<void(State&)> func)
+{
+    benchmarks().push_back({ std::move(name), std::move(func) });
+    return true;
+}
+
+inline bool pin(std::size_t cpu)
+{
+    #if SHELL_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #else
+    SHELL_UNUSED(cpu);
+    return false;
+    #endif
+}
+
+// The nearest and the farthest neighbour of cpu 0, or 0-0 on a single core.
+inline std::vector<std::pair<std::size_t, std::size_t>> corePairs()
+{
+    std::size_t cpus = std::max(std::thread::hardware_concurrency(), 1u);
+    if (cpus <= 2)
+        return { { 0, cpus - 1 } };
+
+    return { { 0, 1 }, { 0, cpus - 1 } };
+}
+
+// One benchmark per line so baselines can be read back without a JSON parser.
+inline std::string toJson(const std::vector<Result>& results)
+{
+    std::string json = "{\"benchmarks\":[\n";
+    for (const auto& result : results)
+    {
+        shell::formatTo(json, "{{\"name\":\"{}\",\"iterations\":{},\"bytes\":{},\"median_ns\":{},\"mean_ns\":{},\"min_ns\":{},\"stddev_ns\":{},\"cycles\":{},\"cycles_per_byte\":{}}}{}\n",
+            result.name, result.iterations, result.bytes, result.median, result.mean, result.min, result.stddev, result.cycles, result.cyclesPerByte(),
+            &result == &results.back() ? "" : ",");
+    }
+    json += "]}\n";
+    return json;
+}
+
+inline std::vector<Result> fromJson(std::string_view json)
+{
+    auto field = [](std::string_view line, std::string_view key) -> std::string_view
+    {
+        std::size_t begin = line.find(key);
+        if (begin == std::string_view::npos)
+            return {};
+
+        begin += key.size();
+        std::size_t end = line.find_first_of(",\"}", begin);
+        return line.substr(begin, end == std::string_view::npos ? end : end - begin);
+    };
+
+    std::vector<Result> results;
+    while (!json.empty())
+    {
+        std::size_t end = json.find('\n');
+        std::string_view line = json.substr(0, end);
+        json.remove_prefix(end == std::string_view::npos ? json.size() : end + 1);
+
+        std::string_view name = field(line, "\"name\":\"");
+        if (name.empty())
+            continue;
+
+        Result result;
+        result.name = std::string(name);
+        result.median = shell::parse<float>(field(line, "\"median_ns\":")).value_or(0);
+        result.bytes = shell::parse<u64>(field(line, "\"bytes\":")).value_or(0);
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+// Prints the relative change of every benchmark present in both runs and
+// returns the number of regressions beyond the tolerance.
+inline std::size_t compare(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance)
+{
+    std::size_t regressions = 0;
+    for (const auto& result : results)
+    {
+        auto iter = std::find_if(baseline.begin(), baseline.end(), [&](const Result& base) { return base.name == result.name; });
+        if (iter == baseline.end() || iter->median <= 0)
+            continue;
+
+        double change = result.median / iter->median - 1.0;
+        bool regressed = change > tolerance;
+        regressions += regressed;
+
+        shell::print("{:<56} {:>12.2f} ns {:>12.2f} ns {:>+8.1f}%{}\n",
+            result.name, iter->median, result.median, 100.0 * change, regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+}  // namespace bench
+
+#define BENCHMARK_IMPL(function, name)                                              \
+    static void function(bench::State&);                                            \
+    static const bool SHELL_CONCAT(function, _registered) = bench::add(name, function); \
+    static void function(bench::State& state)
+
+#define BENCHMARK(name) BENCHMARK_IMPL(SHELL_CONCAT(bench_, __COUNTER__), name)
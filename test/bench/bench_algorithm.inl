@@ -0,0 +1,40 @@
+static std::string csvLine(std::size_t fields)
+{
+    std::string line;
+    for (std::size_t i = 0; i < fields; ++i)
+        line += shell::format("{}field{}", i ? "," : "", i);
+    return line;
+}
+
+BENCHMARK("algorithm::split/string")
+{
+    std::string line = csvLine(32);
+    state.setBytes(line.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(split(line, ","));
+    });
+}
+
+BENCHMARK("algorithm::split/string_view")
+{
+    std::string data = csvLine(32);
+    std::string_view line = data;
+    state.setBytes(line.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(split(line, ","));
+    });
+}
+
+BENCHMARK("algorithm::split/arena")
+{
+    std::string line = csvLine(32);
+    Arena arena;
+    state.setBytes(line.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(split(line, ",", std::pmr::polymorphic_allocator<std::string>(&arena)));
+        arena.reset();
+    });
+}
@@ -0,0 +1,85 @@
+static constexpr std::size_t kBillion = 1'000'000'000;
+
+static bit::DynamicBitSet randomBitSet(std::size_t size, std::size_t every, u64 seed)
+{
+    std::mt19937_64 rng(seed);
+    bit::DynamicBitSet bits(size);
+    for (std::size_t i = 0; i < size / every; ++i)
+        bits.set(rng() % size);
+    return bits;
+}
+
+BENCHMARK("bitset::BitSet<4096>/count")
+{
+    bit::BitSet<4096> bits;
+    for (std::size_t i = 0; i < bits.size(); i += 3)
+        bits.set(i);
+
+    state.setBytes(bits.size() / 8);
+    state.run([&]()
+    {
+        bench::doNotOptimize(bits.count());
+    });
+}
+
+BENCHMARK("bitset::BitSet<4096>/and")
+{
+    bit::BitSet<4096> a;
+    bit::BitSet<4096> b;
+    b.set();
+
+    state.setBytes(a.size() / 8);
+    state.run([&]()
+    {
+        a &= b;
+        bench::doNotOptimize(a);
+    });
+}
+
+BENCHMARK("bitset::DynamicBitSet/1G/count")
+{
+    auto bits = randomBitSet(kBillion, 64, 1);
+    state.setBytes(kBillion / 8);
+    state.run([&]()
+    {
+        bench::doNotOptimize(bits.count());
+    });
+}
+
+BENCHMARK("bitset::DynamicBitSet/1G/iterate")
+{
+    auto bits = randomBitSet(kBillion, 64, 1);
+    state.setBytes(kBillion / 8);
+    state.run([&]()
+    {
+        std::size_t sum = 0;
+        for (std::size_t index : bits)
+            sum += index;
+        bench::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK("bitset::DynamicBitSet/1G/findNext")
+{
+    auto bits = randomBitSet(kBillion, 4096, 2);
+    state.setBytes(kBillion / 8);
+    state.run([&]()
+    {
+        std::size_t found = 0;
+        for (std::size_t i = bits.findFirst(); i < bits.size(); i = bits.findNext(i))
+            found++;
+        bench::doNotOptimize(found);
+    });
+}
+
+BENCHMARK("bitset::DynamicBitSet/1G/or")
+{
+    auto a = randomBitSet(kBillion, 64, 3);
+    auto b = randomBitSet(kBillion, 64, 4);
+    state.setBytes(kBillion / 8);
+    state.run([&]()
+    {
+        a |= b;
+        bench::doNotOptimize(a);
+    });
+}
@@ -0,0 +1,33 @@
+static std::size_t writeVarints(std::vector<u8>& data)
+{
+    bit::BitWriter<> writer(data);
+    for (u64 i = 0; i < 4096; ++i)
+        writer.writeVarint(i * i * i);
+    return writer.flush();
+}
+
+BENCHMARK("bitstream::BitWriter::writeVarint")
+{
+    std::vector<u8> data(16 * 4096);
+    state.setBytes(writeVarints(data));
+    state.run([&]()
+    {
+        bench::doNotOptimize(writeVarints(data));
+    });
+}
+
+BENCHMARK("bitstream::BitReader::readVarint")
+{
+    std::vector<u8> data(16 * 4096);
+    data.resize(writeVarints(data));
+
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        bit::BitReader<> reader(data);
+        u64 sum = 0;
+        for (u64 i = 0; i < 4096; ++i)
+            sum += reader.readVarint();
+        bench::doNotOptimize(sum);
+    });
+}
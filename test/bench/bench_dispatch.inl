@@ -0,0 +1,121 @@
+// Every handler mixes its index into the accumulator differently enough
+// that the compiler cannot fold the switch into arithmetic.
+template<std::size_t kIndex>
+SHELL_INLINE u64 step(u64 acc)
+{
+    return (acc ^ (kIndex * 0x9E3779B97F4A7C15ULL)) + (acc >> (kIndex % 29 + 1));
+}
+
+struct Step
+{
+    template<std::size_t kIndex>
+    static u64 handle(u64 acc)
+    {
+        return step<kIndex>(acc);
+    }
+};
+
+struct Interpreter
+{
+    const u8* pc;
+    const u8* end;
+    u64 acc;
+};
+
+struct ThreadedStep
+{
+    template<std::size_t kIndex>
+    static u64 handle(Interpreter& vm);
+};
+
+using StepTable = JumpTable<256, Step, u64(u64)>;
+using ThreadedTable = JumpTable<256, ThreadedStep, u64(Interpreter&)>;
+
+template<std::size_t kIndex>
+u64 ThreadedStep::handle(Interpreter& vm)
+{
+    vm.acc = step<kIndex>(vm.acc);
+#if SHELL_HAS_MUSTTAIL
+    if (vm.pc == vm.end)
+        return vm.acc;
+
+    SHELL_MUSTTAIL return ThreadedTable::kTable[*vm.pc++](vm);
+#else
+    return vm.acc;
+#endif
+}
+
+static std::vector<u8> program()
+{
+    std::mt19937_64 rng(256);
+    std::vector<u8> program(4096);
+    for (auto& op : program)
+        op = static_cast<u8>(rng());
+    return program;
+}
+
+BENCHMARK("dispatch::switch")
+{
+    auto ops = program();
+    state.setBytes(ops.size());
+    state.run([&]()
+    {
+        u64 acc = 0;
+        for (u8 op : ops)
+        {
+            switch (op)
+            {
+            SHELL_CASE64(  0, acc = step<kLabel>(acc));
+            SHELL_CASE64( 64, acc = step<kLabel>(acc));
+            SHELL_CASE64(128, acc = step<kLabel>(acc));
+            SHELL_CASE64(192, acc = step<kLabel>(acc));
+            }
+        }
+        bench::doNotOptimize(acc);
+    });
+}
+
+BENCHMARK("dispatch::JumpTable")
+{
+    auto ops = program();
+    state.setBytes(ops.size());
+    state.run([&]()
+    {
+        u64 acc = 0;
+        for (u8 op : ops)
+            acc = StepTable::dispatch(op, acc);
+        bench::doNotOptimize(acc);
+    });
+}
+
+BENCHMARK("dispatch::JumpTable/threaded")
+{
+    auto ops = program();
+    state.setBytes(ops.size());
+    state.run([&]()
+    {
+        Interpreter vm{ ops.data() + 1, ops.data() + ops.size(), 0 };
+#if SHELL_HAS_MUSTTAIL
+        bench::doNotOptimize(ThreadedTable::dispatch(ops[0], vm));
+#else
+        // Trampoline, every handler returns to this loop.
+        ThreadedTable::dispatch(ops[0], vm);
+        while (vm.pc != vm.end)
+            ThreadedTable::dispatch(*vm.pc++, vm);
+        bench::doNotOptimize(vm.acc);
+#endif
+    });
+}
+
+BENCHMARK("dispatch::dispatch")
+{
+    auto ops = program();
+    state.setBytes(ops.size());
+    state.run([&]()
+    {
+        u64 acc = 0;
+        for (u8 op : ops)
+            acc = dispatch<256>(op, [acc](auto kIndex) { return step<kIndex>(acc); });
+        bench::doNotOptimize(acc);
+    });
+}
@@ -0,0 +1,53 @@
+BENCHMARK("format::request/runtime")
+{
+    state.run([&]()
+    {
+        bench::doNotOptimize(shell::format("request {} took {:.3f} ms", 42, 1.25));
+    });
+}
+
+BENCHMARK("format::request/compiled")
+{
+    state.run([&]()
+    {
+        bench::doNotOptimize(shell::format(SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25));
+    });
+}
+
+BENCHMARK("format::login/runtime")
+{
+    std::string user = "alice";
+    state.run([&]()
+    {
+        bench::doNotOptimize(shell::format("user {} logged in from {}:{}", user, "192.168.0.1", 8080));
+    });
+}
+
+BENCHMARK("format::login/compiled")
+{
+    std::string user = "alice";
+    state.run([&]()
+    {
+        bench::doNotOptimize(shell::format(SHELL_FORMAT("user {} logged in from {}:{}"), user, "192.168.0.1", 8080));
+    });
+}
+
+BENCHMARK("format::formatTo/memory_buffer")
+{
+    fmt::memory_buffer buffer;
+    state.run([&]()
+    {
+        buffer.clear();
+        bench::doNotOptimize(shell::formatTo(buffer, SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25));
+    });
+}
+
+BENCHMARK("format::formatTo/FixedBuffer")
+{
+    FixedBuffer<char, 64> buffer;
+    state.run([&]()
+    {
+        buffer.clear();
+        bench::doNotOptimize(shell::formatTo(buffer, SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25));
+    });
+}
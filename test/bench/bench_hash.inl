@@ -0,0 +1,34 @@
+static std::vector<u8> randomBytes(std::size_t size)
+{
+    std::mt19937_64 rng(size);
+    std::vector<u8> data(size);
+    for (auto& byte : data)
+        byte = static_cast<u8>(rng());
+    return data;
+}
+
+template<std::size_t kSize>
+static void benchMurmur(bench::State& state)
+{
+    auto data = randomBytes(kSize);
+    state.setBytes(kSize);
+    state.run([&]()
+    {
+        bench::doNotOptimize(murmur(data.data(), data.size(), 0));
+    });
+}
+
+BENCHMARK("hash::murmur/16")
+{
+    benchMurmur<16>(state);
+}
+
+BENCHMARK("hash::murmur/1KiB")
+{
+    benchMurmur<1024>(state);
+}
+
+BENCHMARK("hash::murmur/64KiB")
+{
+    benchMurmur<64 * 1024>(state);
+}
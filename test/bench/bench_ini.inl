@@ -0,0 +1,50 @@
+static std::string iniData(std::size_t sections, std::size_t values)
+{
+    std::string data;
+    for (std::size_t i = 0; i < sections; ++i)
+    {
+        data += shell::format("# section {}\n[section{}]\n", i, i);
+        for (std::size_t j = 0; j < values; ++j)
+            data += shell::format("key{} = value {} of section {}\n", j, j, i);
+        data += "\n";
+    }
+    return data;
+}
+
+BENCHMARK("ini::parse")
+{
+    std::string data = iniData(16, 16);
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        Ini ini;
+        ini.parse(data);
+        bench::doNotOptimize(ini);
+    });
+}
+
+BENCHMARK("ini::parse/arena")
+{
+    std::string data = iniData(16, 16);
+    Arena arena;
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        {
+            Ini ini(&arena);
+            ini.parse(data);
+            bench::doNotOptimize(ini);
+        }
+        arena.reset();
+    });
+}
+
+BENCHMARK("ini::find")
+{
+    Ini ini;
+    ini.parse(iniData(16, 16));
+    state.run([&]()
+    {
+        bench::doNotOptimize(ini.find<std::string>("section15", "key15"));
+    });
+}
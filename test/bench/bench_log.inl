@@ -0,0 +1,142 @@
+#if SHELL_OS_WINDOWS
+static const char* kNullFile = "NUL";
+#else
+static const char* kNullFile = "/dev/null";
+#endif
+
+class NullSink : public BasicSink
+{
+public:
+    void sink(const std::string& message, Level)
+    {
+        bench::doNotOptimize(message);
+    }
+
+    void sink(const std::string& message, Level, const std::string&)
+    {
+        bench::doNotOptimize(message);
+    }
+};
+
+template<typename Sink, typename Function>
+static void benchSink(bench::State& state, Sink&& sink, Function func)
+{
+    setSink(std::forward<Sink>(sink));
+    state.run(func);
+    setSink(ColoredConsoleSink());
+}
+
+BENCHMARK("log::info/runtime")
+{
+    benchSink(state, NullSink(), []()
+    {
+        shell::info("request {} took {:.3f} ms", 42, 1.25);
+    });
+}
+
+BENCHMARK("log::info/compiled")
+{
+    benchSink(state, NullSink(), []()
+    {
+        shell::info(SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+    });
+}
+
+BENCHMARK("log::SHELL_LOG_INFO")
+{
+    benchSink(state, NullSink(), []()
+    {
+        SHELL_LOG_INFO(SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+    });
+}
+
+BENCHMARK("log::SHELL_LOG_EVERY_N/suppressed")
+{
+    benchSink(state, NullSink(), []()
+    {
+        SHELL_LOG_EVERY_N(Level::Info, 1'000'000'000, SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+    });
+}
+
+static void logEveryN()
+{
+    SHELL_LOG_EVERY_N(Level::Info, 1'000'000'000, SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+}
+
+static void logSampled()
+{
+    SHELL_LOG_SAMPLE(Level::Info, 0.0, SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+}
+
+// Splits the iterations over threads that share one call site.
+template<typename Function>
+static void benchContended(bench::State& state, Function func)
+{
+    constexpr u64 kThreads = 4;
+
+    setSink(NullSink());
+    state.runBatch([&](u64 iterations)
+    {
+        std::vector<std::thread> threads;
+        for (u64 i = 0; i < kThreads; ++i)
+        {
+            threads.emplace_back([&, i]()
+            {
+                for (u64 j = i; j < iterations; j += kThreads)
+                    func();
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    });
+    setSink(ColoredConsoleSink());
+}
+
+BENCHMARK("log::SHELL_LOG_EVERY_N/suppressed/contended")
+{
+    benchContended(state, logEveryN);
+}
+
+BENCHMARK("log::SHELL_LOG_SAMPLE/suppressed")
+{
+    benchSink(state, NullSink(), logSampled);
+}
+
+BENCHMARK("log::SHELL_LOG_SAMPLE/suppressed/contended")
+{
+    benchContended(state, logSampled);
+}
+
+BENCHMARK("log::FileSink")
+{
+    benchSink(state, FileSink(kNullFile), []()
+    {
+        SHELL_LOG_INFO(SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+    });
+}
+
+BENCHMARK("log::RotatingFileSink")
+{
+    benchSink(state, RotatingFileSink(kNullFile, {}), []()
+    {
+        SHELL_LOG_INFO(SHELL_FORMAT("request {} took {:.3f} ms"), 42, 1.25);
+    });
+}
+
+BENCHMARK("log::BinarySink")
+{
+    BinarySink sink(kNullFile);
+    state.run([&]()
+    {
+        SHELL_LOG_BINARY(sink, Level::Info, "request {} took {:.3f} ms", 42, 1.25);
+    });
+}
+
+BENCHMARK("log::BinarySink/setSink")
+{
+    benchSink(state, BinarySink(kNullFile), []()
+    {
+        SHELL_LOG_INFO("request {} took {:.3f} ms", 42, 1.25);
+    });
+}
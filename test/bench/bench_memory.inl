@@ -0,0 +1,32 @@
+BENCHMARK("memory::new/64")
+{
+    state.run([&]()
+    {
+        auto* data = new u8[64];
+        bench::doNotOptimize(data);
+        delete[] data;
+    });
+}
+
+BENCHMARK("memory::Arena/64")
+{
+    Arena arena;
+    u64 allocations = 0;
+    state.run([&]()
+    {
+        bench::doNotOptimize(arena.allocate(64, 8));
+        if (++allocations % 1024 == 0)
+            arena.reset();
+    });
+}
+
+BENCHMARK("memory::Pool/create+destroy")
+{
+    Pool<std::array<u64, 8>> pool;
+    state.run([&]()
+    {
+        auto* value = pool.create();
+        bench::doNotOptimize(value);
+        pool.destroy(value);
+    });
+}
@@ -0,0 +1,43 @@
+BENCHMARK("metrics::Counter::add")
+{
+    metrics::Counter counter;
+    state.run([&]()
+    {
+        counter.add();
+    });
+    bench::doNotOptimize(counter.value());
+}
+
+BENCHMARK("metrics::Gauge::set")
+{
+    metrics::Gauge gauge;
+    s64 value = 0;
+    state.run([&]()
+    {
+        gauge.set(value++);
+    });
+}
+
+BENCHMARK("metrics::Histogram::record")
+{
+    metrics::Histogram histogram;
+    u64 value = 0;
+    state.run([&]()
+    {
+        histogram.record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    });
+}
+
+BENCHMARK("metrics::HistogramSnapshot::percentile")
+{
+    metrics::Histogram histogram;
+    for (u64 i = 0; i < 100000; ++i)
+        histogram.record(i * i);
+
+    auto snapshot = histogram.snapshot();
+    state.run([&]()
+    {
+        bench::doNotOptimize(snapshot.percentile(99));
+    });
+}
@@ -0,0 +1,29 @@
+BENCHMARK("parse::int")
+{
+    std::string data = "-123456789";
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(parse<int>(data));
+    });
+}
+
+BENCHMARK("parse::u64/hex")
+{
+    std::string data = "0xDEADBEEFCAFE";
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(parse<u64>(data));
+    });
+}
+
+BENCHMARK("parse::float")
+{
+    std::string data = "3.14159265";
+    state.setBytes(data.size());
+    state.run([&]()
+    {
+        bench::doNotOptimize(parse<float>(data));
+    });
+}
@@ -0,0 +1,16 @@
+BENCHMARK("profile::SHELL_PROFILE_SCOPE")
+{
+    auto drain = []()
+    {
+        shell::detail::Profiler::instance().consume([](u32, const auto&) {});
+    };
+
+    u64 scopes = 0;
+    state.run([&]()
+    {
+        SHELL_PROFILE_SCOPE("bench");
+        if (++scopes % 65536 == 0)
+            drain();
+    });
+    drain();
+}
@@ -0,0 +1,61 @@
+static std::vector<float> randomFloats(std::size_t size, u64 seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    std::vector<float> values(size);
+    for (auto& value : values)
+        value = distribution(rng);
+    return values;
+}
+
+BENCHMARK("ranges::dot/indexed")
+{
+    auto a = randomFloats(4096, 1);
+    auto b = randomFloats(4096, 2);
+    state.setBytes(2 * sizeof(float) * a.size());
+    state.run([&]()
+    {
+        float sum = 0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            sum += a[i] * b[i];
+        bench::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK("ranges::dot/zip")
+{
+    auto a = randomFloats(4096, 1);
+    auto b = randomFloats(4096, 2);
+    state.setBytes(2 * sizeof(float) * a.size());
+    state.run([&]()
+    {
+        float sum = 0;
+        for (auto [x, y] : zip(a, b))
+            sum += x * y;
+        bench::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK("ranges::scale/indexed")
+{
+    auto a = randomFloats(4096, 1);
+    state.setBytes(sizeof(float) * a.size());
+    state.run([&]()
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            a[i] = a[i] * 0.5f + static_cast<float>(i);
+        bench::doNotOptimize(a);
+    });
+}
+
+BENCHMARK("ranges::scale/enumerate")
+{
+    auto a = randomFloats(4096, 1);
+    state.setBytes(sizeof(float) * a.size());
+    state.run([&]()
+    {
+        for (auto [i, x] : enumerate(a))
+            x = x * 0.5f + static_cast<float>(i);
+        bench::doNotOptimize(a);
+    });
+}
@@ -0,0 +1,118 @@
+BENCHMARK("ringbuffer::RingBuffer/write+read")
+{
+    RingBuffer<u64, 1024> buffer;
+    u64 value = 0;
+    state.setBytes(sizeof(u64));
+    state.run([&]()
+    {
+        buffer.write(value++);
+        bench::doNotOptimize(buffer.read());
+    });
+}
+
+BENCHMARK("ringbuffer::RingBuffer/bulk")
+{
+    RingBuffer<u64, 1024> buffer;
+    std::vector<u64> src(256, 1);
+    std::vector<u64> dst(256);
+    state.setBytes(src.size() * sizeof(u64));
+    state.run([&]()
+    {
+        buffer.write(src.data(), src.size());
+        buffer.read(dst.data(), dst.size());
+        bench::doNotOptimize(dst);
+    });
+}
+
+template<typename Producer, typename Consumer>
+static void runPinned(std::pair<std::size_t, std::size_t> cpus, Producer producer, Consumer consumer)
+{
+    std::thread consumerThread([&]()
+    {
+        bench::pin(cpus.second);
+        consumer();
+    });
+    std::thread producerThread([&]()
+    {
+        bench::pin(cpus.first);
+        producer();
+    });
+    producerThread.join();
+    consumerThread.join();
+}
+
+static void registerRingBufferPairs()
+{
+    for (auto cpus : bench::corePairs())
+    {
+        bench::add(shell::format("ringbuffer::SpscRingBuffer/throughput/cpu{}-cpu{}", cpus.first, cpus.second), [cpus](bench::State& state)
+        {
+            state.setBytes(sizeof(u64));
+            state.runBatch([&](u64 iterations)
+            {
+                SpscRingBuffer<u64, 1024> buffer;
+                runPinned(cpus,
+                    [&]() { for (u64 i = 0; i < iterations; ++i) buffer.push(i); },
+                    [&]() { for (u64 i = 0; i < iterations; ++i) bench::doNotOptimize(buffer.pop()); });
+            });
+        });
+
+        bench::add(shell::format("ringbuffer::SpscRingBuffer/batch/cpu{}-cpu{}", cpus.first, cpus.second), [cpus](bench::State& state)
+        {
+            state.setBytes(sizeof(u64));
+            state.runBatch([&](u64 iterations)
+            {
+                SpscRingBuffer<u64, 1024> buffer;
+                runPinned(cpus,
+                    [&]()
+                    {
+                        u64 data[64] = {};
+                        for (u64 pushed = 0; pushed < iterations; )
+                        {
+                            if (std::size_t size = buffer.try_push(data, std::min<u64>(64, iterations - pushed)))
+                                pushed += size;
+                            else
+                                std::this_thread::yield();
+                        }
+                    },
+                    [&]()
+                    {
+                        u64 data[64];
+                        for (u64 popped = 0; popped < iterations; )
+                        {
+                            if (std::size_t size = buffer.try_pop(data, 64))
+                                popped += size;
+                            else
+                                std::this_thread::yield();
+                        }
+                    });
+            });
+        });
+
+        bench::add(shell::format("ringbuffer::SpscRingBuffer/roundtrip/cpu{}-cpu{}", cpus.first, cpus.second), [cpus](bench::State& state)
+        {
+            state.runBatch([&](u64 iterations)
+            {
+                SpscRingBuffer<u64, 64> ping;
+                SpscRingBuffer<u64, 64> pong;
+                runPinned(cpus,
+                    [&]() { for (u64 i = 0; i < iterations; ++i) { ping.push(i); bench::doNotOptimize(pong.pop()); } },
+                    [&]() { for (u64 i = 0; i < iterations; ++i) pong.push(ping.pop()); });
+            });
+        });
+
+        bench::add(shell::format("ringbuffer::MpmcRingBuffer/throughput/cpu{}-cpu{}", cpus.first, cpus.second), [cpus](bench::State& state)
+        {
+            state.setBytes(sizeof(u64));
+            state.runBatch([&](u64 iterations)
+            {
+                MpmcRingBuffer<u64, 1024> buffer;
+                runPinned(cpus,
+                    [&]() { for (u64 i = 0; i < iterations; ++i) buffer.push(i); },
+                    [&]() { for (u64 i = 0; i < iterations; ++i) bench::doNotOptimize(buffer.pop()); });
+            });
+        });
+    }
+}
+
+static const bool kRingBufferPairs = (registerRingBufferPairs(), true);
@@ -0,0 +1,140 @@
+#include <random>
+#include <vector>
+
+#include <shell/algorithm.h>
+#include <shell/bitset.h>
+#include <shell/bitstream.h>
+#include <shell/buffer.h>
+#include <shell/dispatch.h>
+#include <shell/errors.h>
+#include <shell/filesystem.h>
+#include <shell/format.h>
+#include <shell/hash.h>
+#include <shell/ini.h>
+#include <shell/int.h>
+#include <shell/log/all.h>
+#include <shell/log/binary.h>
+#include <shell/log/limit.h>
+#include <shell/log/rotating.h>
+#include <shell/macros.h>
+#include <shell/main.h>
+#include <shell/memory.h>
+#include <shell/metrics.h>
+#include <shell/options.h>
+#include <shell/parse.h>
+#include <shell/profile.h>
+#include <shell/ranges.h>
+#include <shell/ringbuffer.h>
+
+#include "bench.h"
+
+using namespace shell;
+
+#include "bench_algorithm.inl"
+#include "bench_bitset.inl"
+#include "bench_bitstream.inl"
+#include "bench_dispatch.inl"
+#include "bench_format.inl"
+#include "bench_hash.inl"
+#include "bench_ini.inl"
+#include "bench_log.inl"
+#include "bench_memory.inl"
+#include "bench_metrics.inl"
+#include "bench_parse.inl"
+#include "bench_profile.inl"
+#include "bench_ranges.inl"
+#include "bench_ringbuffer.inl"
+
+int main(int argc, char* argv[])
+{
+    Options options("bench");
+    options.add({ "-f,--filter", "Run benchmarks whose name contains the filter" }, Options::value<std::string>()->optional());
+    options.add({ "-l,--list", "List benchmarks and exit" }, Options::value<bool>(false));
+    options.add({ "-r,--repetitions", "Measured repetitions per benchmark" }, Options::value<std::size_t>(10));
+    options.add({ "-m,--min-time", "Minimum time per repetition in milliseconds" }, Options::value<std::size_t>(20));
+    options.add({ "-o,--output", "Write the results as JSON" }, Options::value<std::string>()->optional());
+    options.add({ "-c,--compare", "Compare the results against a JSON baseline" }, Options::value<std::string>()->optional());
+    options.add({ "-t,--tolerance", "Allowed slowdown against the baseline" }, Options::value<float>(0.1f));
+
+    bench::Config config;
+    std::string filter;
+    std::optional<std::string> output;
+    std::optional<std::string> baseline;
+    float tolerance = 0;
+    bool list = false;
+    try
+    {
+        OptionsResult result = options.parse(argc, argv);
+        filter = result.findOr<std::string>("--filter", "");
+        list = *result.find<bool>("--list");
+        config.repetitions = std::max<std::size_t>(*result.find<std::size_t>("--repetitions"), 1);
+        config.min_time = std::chrono::milliseconds(*result.find<std::size_t>("--min-time"));
+        output = result.find<std::string>("--output");
+        baseline = result.find<std::string>("--compare");
+        tolerance = std::max(*result.find<float>("--tolerance"), 0.0f);
+    }
+    catch (const ParseError& error)
+    {
+        shell::print("{}\n\n{}", error.what(), options.help());
+        return 1;
+    }
+
+    std::vector<bench::Result> results;
+    for (const auto& benchmark : bench::benchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        if (list)
+        {
+            shell::print("{}\n", benchmark.name);
+            continue;
+        }
+
+        bench::State state(config);
+        benchmark.func(state);
+
+        auto result = state.result(benchmark.name);
+        if (!result)
+        {
+            shell::print("{:<56} no measurement\n", benchmark.name);
+            continue;
+        }
+
+        if (result->bytes > 0)
+        {
+            shell::print("{:<56} {:>12.2f} ns {:>6.1f}% {:>10.3f} cycles/byte {:>8.2f} GB/s\n",
+                result->name, result->median, 100.0 * result->stddev / result->mean, result->cyclesPerByte(), result->gigabytesPerSecond());
+        }
+        else
+        {
+            shell::print("{:<56} {:>12.2f} ns {:>6.1f}% {:>10.1f} cycles\n",
+                result->name, result->median, 100.0 * result->stddev / result->mean, result->cycles);
+        }
+        results.push_back(std::move(*result));
+    }
+
+    if (output && filesystem::write(*output, bench::toJson(results)) != filesystem::Status::Ok)
+    {
+        shell::print("Cannot write '{}'\n", *output);
+        return 1;
+    }
+
+    if (baseline)
+    {
+        std::string json;
+        if (filesystem::read(*baseline, json) != filesystem::Status::Ok)
+        {
+            shell::print("Cannot read '{}'\n", *baseline);
+            return 1;
+        }
+
+        shell::print("\n{:<56} {:>15} {:>15} {:>9}\n", "benchmark", "baseline", "current", "change");
+        if (std::size_t regressions = bench::compare(results, bench::fromJson(json), tolerance))
+        {
+            shell::print("\n{} regression(s) beyond {:.0f}%\n", regressions, 100 * tolerance);
+            return 1;
+        }
+    }
+    return 0;
+}
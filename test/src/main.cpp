@@ -1,7 +1,13 @@
+#include <forward_list>
+#include <list>
+
 #include <shell/algorithm.h>
 #include <shell/array.h>
 #include <shell/bit.h>
+#include <shell/bitset.h>
+#include <shell/bitstream.h>
 #include <shell/buffer.h>
+#include <shell/dispatch.h>
 #include <shell/errors.h>
 #include <shell/filesystem.h>
 #include <shell/format.h>
@@ -10,13 +16,21 @@
 #include <shell/int.h>
 #include <shell/locale.h>
 #include <shell/log/all.h>
+#include <shell/log/binary.h>
+#include <shell/log/limit.h>
+#include <shell/log/rotating.h>
 #include <shell/main.h>
 #include <shell/macros.h>
+#include <shell/memory.h>
+#include <shell/metrics.h>
 #include <shell/mp.h>
 #include <shell/operators.h>
 #include <shell/options.h>
+#include <shell/parallel.h>
+#include <shell/profile.h>
 #include <shell/ranges.h>
 #include <shell/ringbuffer.h>
+#include <shell/soa.h>
 #include <shell/traits.h>
 #include <shell/utility.h>
 
@@ -29,7 +43,10 @@ using namespace std::string_literals;
 #include "tests_algorithm.inl"
 #include "tests_array.inl"
 #include "tests_bit.inl"
+#include "tests_bitset.inl"
+#include "tests_bitstream.inl"
 #include "tests_buffer.inl"
+#include "tests_dispatch.inl"
 #include "tests_errors.inl"
 #include "tests_filesystem.inl"
 #include "tests_format.inl"
@@ -39,10 +56,15 @@ using namespace std::string_literals;
 #include "tests_log.inl"
 #include "tests_operators.inl"
 #include "tests_options.inl"
+#include "tests_parallel.inl"
 #include "tests_macros.inl"
+#include "tests_memory.inl"
+#include "tests_metrics.inl"
 #include "tests_mp.inl"
 #include "tests_parse.inl"
+#include "tests_profile.inl"
 #include "tests_ranges.inl"
 #include "tests_ringbuffer.inl"
+#include "tests_soa.inl"
 #include "tests_traits.inl"
 #include "tests_utility.inl"
@@ -91,6 +91,14 @@ TEST_CASE("algorithm::trim")
     std::string t0 = "  -  ";
     trim(t0);
     REQUIRE(t0 == "-");
+
+    std::string_view t1 = "  -  ";
+    trim(t1);
+    REQUIRE(t1 == "-");
+
+    std::string_view t2 = "   ";
+    trim(t2);
+    REQUIRE(t2.empty());
 }
 
 TEST_CASE("algorithm::trimCopyIf")
@@ -183,6 +191,20 @@ TEST_CASE("algorithm::split")
     REQUIRE(parts[1] == "xxx");
 }
 
+TEST_CASE("algorithm::split::allocator")
+{
+    Arena arena;
+
+    auto parts = split(std::pmr::string("xxx|yyy|zzz"), "|", std::pmr::polymorphic_allocator<std::pmr::string>(&arena));
+    REQUIRE(parts.size() == 3);
+    REQUIRE(parts[1] == "yyy");
+    REQUIRE(parts.get_allocator().resource() == &arena);
+    REQUIRE(parts[2].get_allocator().resource() == &arena);
+
+    REQUIRE(splitFirst("xxx|yyy|zzz"s, "|", std::allocator<std::string>()) == std::vector<std::string>{ "xxx", "yyy|zzz" });
+    REQUIRE(splitLast("xxx|yyy|zzz"s, "|", std::allocator<std::string>()) == std::vector<std::string>{ "xxx|yyy", "zzz" });
+}
+
 TEST_CASE("algorithm::splitFirst")
 {
     REQUIRE(splitFirst("xxx"s, "|") == std::vector<std::string>{ "xxx" });
@@ -171,6 +171,58 @@ TEST_CASE("bit::byteSwap")
     REQUIRE(bit::byteSwap(0xABCD'ABCD) == 0xCDAB'CDAB);
 }
 
+template<typename Integral>
+void testByteSwapRange()
+{
+    for (std::size_t size : { 0, 1, 7, 16, 33, 100 })
+    {
+        std::vector<Integral> data(size);
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<Integral>(0x0123'4567'89AB'CDEFULL * (i + 1));
+
+        std::vector<Integral> expected(data);
+        for (auto& value : expected)
+            value = bit::byteSwap(value);
+
+        bit::byteSwapRange(data);
+        REQUIRE(data == expected);
+    }
+}
+
+TEST_CASE("bit::byteSwapRange")
+{
+    testByteSwapRange<u16>();
+    testByteSwapRange<u32>();
+    testByteSwapRange<u64>();
+    testByteSwapRange<s32>();
+}
+
+TEST_CASE("bit::load")
+{
+    const u8 data[9] = { 0xFF, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF };
+
+    REQUIRE(bit::load<u16, bit::Endian::Little>(data + 1) == 0x2301);
+    REQUIRE(bit::load<u16, bit::Endian::Big   >(data + 1) == 0x0123);
+    REQUIRE(bit::load<u32, bit::Endian::Little>(data + 1) == 0x6745'2301);
+    REQUIRE(bit::load<u32, bit::Endian::Big   >(data + 1) == 0x0123'4567);
+    REQUIRE(bit::load<u64, bit::Endian::Little>(data + 1) == 0xEFCD'AB89'6745'2301);
+    REQUIRE(bit::load<u64, bit::Endian::Big   >(data + 1) == 0x0123'4567'89AB'CDEF);
+}
+
+TEST_CASE("bit::store")
+{
+    u8 data[9] = {};
+
+    bit::store<u32, bit::Endian::Big>(data + 1, 0x0123'4567);
+    REQUIRE(data[1] == 0x01);
+    REQUIRE(data[4] == 0x67);
+
+    bit::store<u64, bit::Endian::Little>(data + 1, 0x0123'4567'89AB'CDEF);
+    REQUIRE(data[1] == 0xEF);
+    REQUIRE(data[8] == 0x01);
+    REQUIRE(bit::load<u64>(data + 1) == bit::load<u64, bit::Endian::Native>(data + 1));
+}
+
 TEST_CASE("bit::bitSwap")
 {
     REQUIRE(bit::bitSwap(0x0000'0001) == 0x8000'0000);
@@ -214,6 +266,17 @@ TEST_CASE("bit::popcnt")
     REQUIRE(bit::popcnt(0xFFFF'FFFF) == 32);
 }
 
+TEST_CASE("bit::isPowTwo")
+{
+    REQUIRE(!bit::isPowTwo<uint>(0));
+    REQUIRE( bit::isPowTwo<uint>(1));
+    REQUIRE( bit::isPowTwo<uint>(2));
+    REQUIRE(!bit::isPowTwo<uint>(3));
+    REQUIRE( bit::isPowTwo<uint>(4));
+    REQUIRE(!bit::isPowTwo<uint>(6));
+    REQUIRE( bit::isPowTwo<u64>(1ULL << 63));
+}
+
 TEST_CASE("bit::ceilPowTwo")
 {
     REQUIRE(bit::ceilPowTwo<uint>(2) == 2);
@@ -229,6 +292,126 @@ TEST_CASE("bit::ceilPowTwoSafe")
     REQUIRE(bit::ceilPowTwoSafe<uint>(1) == 1);
 }
 
+TEST_CASE("bit::extract")
+{
+    REQUIRE(bit::extract<u32>(0xDEAD'BEEF, 0x0000'0000) == 0x0000'0000);
+    REQUIRE(bit::extract<u32>(0xDEAD'BEEF, 0x0000'FFFF) == 0x0000'BEEF);
+    REQUIRE(bit::extract<u32>(0xDEAD'BEEF, 0xFFFF'0000) == 0x0000'DEAD);
+    REQUIRE(bit::extract<u32>(0xDEAD'BEEF, 0xF0F0'F0F0) == 0x0000'DABE);
+    REQUIRE(bit::extract<u64>(0xDEAD'BEEF'0000'0000, 0xFFFF'0000'0000'0000) == 0xDEAD);
+    REQUIRE(bit::extract<u8>(0xA5, 0x0F) == 0x05);
+}
+
+TEST_CASE("bit::deposit")
+{
+    REQUIRE(bit::deposit<u32>(0x0000'BEEF, 0x0000'0000) == 0x0000'0000);
+    REQUIRE(bit::deposit<u32>(0x0000'BEEF, 0xFFFF'0000) == 0xBEEF'0000);
+    REQUIRE(bit::deposit<u32>(0x0000'DABE, 0xF0F0'F0F0) == 0xD0A0'B0E0);
+    REQUIRE(bit::deposit<u64>(0xDEAD, 0xFFFF'0000'0000'0000) == 0xDEAD'0000'0000'0000);
+    REQUIRE(bit::deposit<u8>(0x05, 0xF0) == 0x50);
+}
+
+TEST_CASE("bit::extractDeposit")
+{
+    u64 value = 0x0123'4567'89AB'CDEF;
+    u64 mask  = 0xF00F'0FF0'00FF'F0F1;
+    for (int i = 0; i < 64; ++i)
+    {
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        mask  = bit::ror(mask, 7) ^ value;
+
+        REQUIRE(bit::extract(value, mask) == bit::detail::extract(value, mask));
+        REQUIRE(bit::deposit(value, mask) == bit::detail::deposit(value, mask));
+        REQUIRE(bit::deposit(bit::extract(value, mask), mask) == (value & mask));
+    }
+}
+
+TEST_CASE("bit::Layout")
+{
+    using Instruction = bit::Layout<u32,
+        bit::Field< 0, 4>,
+        bit::Field<12, 4>,
+        bit::Field<16, 4>,
+        bit::Field<20, 5>>;
+
+    REQUIRE(Instruction::kMask == 0x01FF'F00F);
+
+    auto fields = Instruction::unpack(0xE1A0'2003);
+    REQUIRE(fields[0] == 0x3);
+    REQUIRE(fields[1] == 0x2);
+    REQUIRE(fields[2] == 0x0);
+    REQUIRE(fields[3] == 0x1A);
+
+    REQUIRE(Instruction::pack(fields) == (0xE1A0'2003 & Instruction::kMask));
+    REQUIRE(Instruction::pack(0x3, 0x2, 0x0, 0x1A) == 0x01A0'2003);
+
+    struct Decoded
+    {
+        u32 rm;
+        u32 rd;
+        u32 rn;
+        u32 opcode;
+    };
+
+    auto decoded = Instruction::unpack<Decoded>(0xE1A0'2003);
+    REQUIRE(decoded.rm == 0x3);
+    REQUIRE(decoded.rd == 0x2);
+    REQUIRE(decoded.rn == 0x0);
+    REQUIRE(decoded.opcode == 0x1A);
+}
+
+TEST_CASE("bit::constexpr")
+{
+    static_assert(bit::popcnt(0xF0F0'0001U) == 9);
+    static_assert(bit::popcnt<u64>(0) == 0);
+    static_assert(bit::clz<u8>(0x01) == 7);
+    static_assert(bit::clz<u32>(0x0001'0000) == 15);
+    static_assert(bit::clzSafe<u16>(0) == 16);
+    static_assert(bit::ctz<u64>(0x0100'0000'0000) == 40);
+    static_assert(bit::ctzSafe<u32>(0) == 32);
+    static_assert(bit::ror<u8>(0x01, 1) == 0x80);
+    static_assert(bit::rol<u32>(0x8000'0001, 4) == 0x0000'0018);
+    static_assert(bit::byteSwap<u32>(0x0123'4567) == 0x6745'2301);
+    static_assert(bit::byteSwap<u16>(0xABCD) == 0xCDAB);
+    static_assert(bit::bitSwap<u8>(0x01) == 0x80);
+    static_assert(bit::bitSwap<u32>(0x0000'0003) == 0xC000'0000);
+    static_assert(bit::ceilPowTwo(17U) == 32);
+    static_assert(bit::ceilPowTwoSafe(0U) == 1);
+
+    for (u32 x : { 0x0000'0001U, 0x1234'5678U, 0x8000'0000U, 0xFFFF'FFFFU })
+    {
+        REQUIRE(bit::detail::popcnt(x) == bit::popcnt(x));
+        REQUIRE(bit::detail::clz(x) == bit::clz(x));
+        REQUIRE(bit::detail::ctz(x) == bit::ctz(x));
+        REQUIRE(bit::detail::ror(x, 13) == bit::ror(x, 13));
+        REQUIRE(bit::detail::rol(x, 13) == bit::rol(x, 13));
+        REQUIRE(bit::detail::byteSwap(x) == bit::byteSwap(x));
+        REQUIRE(bit::detail::bitSwap(x) == bit::bitSwap(x));
+    }
+}
+
+TEST_CASE("bit::makeTable")
+{
+    constexpr auto kPopcnt = bit::makeTable<256>([](std::size_t index)
+    {
+        return static_cast<u8>(bit::popcnt(index));
+    });
+
+    static_assert(kPopcnt[0x00] == 0);
+    static_assert(kPopcnt[0xFF] == 8);
+
+    constexpr auto kReverse = bit::makeTable<256>([](std::size_t index)
+    {
+        return bit::bitSwap(static_cast<u8>(index));
+    });
+
+    for (uint i = 0; i < 256; ++i)
+    {
+        REQUIRE(kPopcnt[i] == bit::popcnt(i));
+        REQUIRE(kReverse[i] == bit::bitSwap(static_cast<u8>(i)));
+    }
+}
+
 template<typename T>
 void compare(T value, const std::vector<std::size_t>& expected)
 {
@@ -0,0 +1,72 @@
+TEST_CASE("bit::BitSet")
+{
+    bit::BitSet<130> x;
+    REQUIRE(x.none());
+    REQUIRE(x.findFirst() == 130);
+
+    x.set(0);
+    x.set(64);
+    x.set(129);
+    REQUIRE(x.count() == 3);
+    REQUIRE(x.test(64));
+    REQUIRE(!x.test(63));
+    REQUIRE(x.findFirst() == 0);
+    REQUIRE(x.findNext(0) == 64);
+    REQUIRE(x.findNext(64) == 129);
+    REQUIRE(x.findNext(129) == 130);
+
+    std::vector<std::size_t> expected = { 0, 64, 129 };
+    std::vector<std::size_t> actual;
+    for (auto index : x)
+        actual.push_back(index);
+
+    REQUIRE(actual == expected);
+
+    bit::BitSet<130> y = ~x;
+    REQUIRE(y.count() == 127);
+    REQUIRE((x & y).none());
+    REQUIRE((x | y).all());
+    REQUIRE((x ^ y).all());
+
+    y.set();
+    y.andNot(x);
+    REQUIRE(y == ~x);
+}
+
+TEST_CASE("bit::DynamicBitSet")
+{
+    bit::DynamicBitSet x(1000);
+    bit::DynamicBitSet y(1000);
+
+    for (std::size_t i = 0; i < 1000; i += 3)
+        x.set(i);
+
+    for (std::size_t i = 0; i < 1000; i += 5)
+        y.set(i);
+
+    REQUIRE(x.count() == 334);
+    REQUIRE(y.count() == 200);
+    REQUIRE((x & y).count() == 67);
+    REQUIRE((x | y).count() == 334 + 200 - 67);
+    REQUIRE((x ^ y).count() == 334 + 200 - 2 * 67);
+    REQUIRE(bit::DynamicBitSet(x).andNot(y).count() == 334 - 67);
+    REQUIRE((~x).count() == 1000 - 334);
+
+    std::size_t expected = 0;
+    for (auto index : x & y)
+    {
+        REQUIRE(index == expected);
+        expected += 15;
+    }
+    REQUIRE(expected == 1005);
+
+    x.resize(1010, true);
+    REQUIRE(x.count() == 344);
+    REQUIRE(x.findNext(999) == 1000);
+
+    bit::DynamicBitSet z(70, true);
+    REQUIRE(z.all());
+    REQUIRE(z.count() == 70);
+    z.resize(10);
+    REQUIRE(z.count() == 10);
+}
@@ -0,0 +1,113 @@
+TEST_CASE("bit::zigZag")
+{
+    REQUIRE(bit::zigZagEncode<s32>( 0) == 0);
+    REQUIRE(bit::zigZagEncode<s32>(-1) == 1);
+    REQUIRE(bit::zigZagEncode<s32>( 1) == 2);
+    REQUIRE(bit::zigZagEncode<s32>(-2) == 3);
+    REQUIRE(bit::zigZagEncode<s64>(std::numeric_limits<s64>::min()) == std::numeric_limits<u64>::max());
+
+    std::array<s64, 5> values = { 0, 1, -1, std::numeric_limits<s64>::max(), std::numeric_limits<s64>::min() };
+    for (s64 x : values)
+        REQUIRE(bit::zigZagDecode(bit::zigZagEncode(x)) == x);
+}
+
+TEST_CASE("bit::BitReader")
+{
+    std::vector<u8> data = { 0b1010'0011, 0b0101'1100, 0xFF, 0x01 };
+
+    bit::BitReader<bit::BitOrder::Lsb> lsb(data);
+    REQUIRE(lsb.read(2) == 0b11);
+    REQUIRE(lsb.read(3) == 0b000);
+    REQUIRE(lsb.read(3) == 0b101);
+    REQUIRE(lsb.read(4) == 0b1100);
+    REQUIRE(lsb.read(12) == 0xFF5);
+    REQUIRE(lsb.position() == 24);
+    REQUIRE(lsb.remaining() == 8);
+    REQUIRE(lsb.read(8) == 0x01);
+    REQUIRE(!lsb.overrun());
+    REQUIRE(lsb.read(8) == 0);
+    REQUIRE(lsb.overrun());
+
+    bit::BitReader<bit::BitOrder::Msb> msb(data);
+    REQUIRE(msb.read(3) == 0b101);
+    REQUIRE(msb.read(5) == 0b00011);
+    REQUIRE(msb.read(4) == 0b0101);
+    REQUIRE(msb.read(12) == 0xCFF);
+    msb.refill();
+    REQUIRE(msb.peek(8) == 0x01);
+    msb.consume(8);
+    REQUIRE(msb.remaining() == 0);
+}
+
+TEST_CASE("bit::BitReader::align")
+{
+    std::array<u8, 3> data = { 0xFF, 0x12, 0x34 };
+
+    bit::BitReader reader(data);
+    REQUIRE(reader.read(3) == 0b111);
+    reader.align();
+    REQUIRE(reader.position() == 8);
+    REQUIRE(reader.read(8) == 0x12);
+    reader.align();
+    REQUIRE(reader.read(8) == 0x34);
+}
+
+template<bit::BitOrder kOrder>
+void testBitStream()
+{
+    std::vector<u8> data(4096);
+
+    bit::BitWriter<kOrder> writer(data);
+    u64 state = 0x9E37'79B9'7F4A'7C15;
+    for (uint i = 0; i < 500; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        writer.write(state >> 7, 1 + i % bit::BitWriter<kOrder>::kMaxBits);
+    }
+    writer.writeVarint(u64(300));
+    writer.writeVarint(std::numeric_limits<u64>::max());
+    writer.writeSignedVarint(s32(-64));
+    writer.writeBit(true);
+
+    std::size_t size = writer.flush();
+    REQUIRE(size == (writer.position() + 7) / 8);
+    REQUIRE(size <= data.size());
+
+    bit::BitReader<kOrder> reader(data.data(), size);
+    state = 0x9E37'79B9'7F4A'7C15;
+    for (uint i = 0; i < 500; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint bits = 1 + i % bit::BitReader<kOrder>::kMaxBits;
+        REQUIRE(reader.read(bits) == ((state >> 7) & bit::ones<u64>(bits)));
+    }
+    REQUIRE(reader.readVarint() == 300);
+    REQUIRE(reader.readVarint() == std::numeric_limits<u64>::max());
+    REQUIRE(reader.template readSignedVarint<s32>() == -64);
+    REQUIRE(reader.readBit());
+    REQUIRE(!reader.overrun());
+}
+
+TEST_CASE("bit::BitWriter")
+{
+    testBitStream<bit::BitOrder::Lsb>();
+    testBitStream<bit::BitOrder::Msb>();
+
+    std::array<u8, 2> data{};
+    bit::BitWriter<bit::BitOrder::Msb> writer(data);
+    writer.write(0b101, 3);
+    writer.write(0x1FFF, 13);
+    REQUIRE(writer.flush() == 2);
+    REQUIRE(data[0] == 0b1011'1111);
+    REQUIRE(data[1] == 0xFF);
+}
+
+TEST_CASE("bit::varint")
+{
+    std::array<u8, 2> data{};
+    bit::BitWriter writer(data);
+    writer.writeVarint<u32>(300);
+    REQUIRE(writer.flush() == 2);
+    REQUIRE(data[0] == 0xAC);
+    REQUIRE(data[1] == 0x02);
+}
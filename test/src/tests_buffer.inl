@@ -28,6 +28,66 @@ TEST_CASE("buffer::FixedBuffer")
     REQUIRE(a.back() == 2);
 }
 
+struct FixedBufferElement
+{
+    static inline int alive = 0;
+
+    explicit FixedBufferElement(int value)
+        : value(value) { alive++; }
+
+    FixedBufferElement(const FixedBufferElement& other)
+        : value(other.value) { alive++; }
+
+    FixedBufferElement(FixedBufferElement&& other)
+        : value(other.value) { alive++; }
+
+    ~FixedBufferElement()
+    {
+        alive--;
+    }
+
+    int value;
+};
+
+TEST_CASE("buffer::FixedBuffer2")
+{
+    {
+        FixedBuffer<FixedBufferElement, 64> a;
+        REQUIRE(a.empty());
+        REQUIRE(FixedBufferElement::alive == 0);
+
+        a.emplace_back(1);
+        a.emplace_back(2);
+        a.push_back(FixedBufferElement(3));
+        REQUIRE(a.size() == 3);
+        REQUIRE(a.back().value == 3);
+        REQUIRE(FixedBufferElement::alive == 3);
+
+        FixedBuffer<FixedBufferElement, 64> b(a);
+        REQUIRE(b.size() == 3);
+        REQUIRE(FixedBufferElement::alive == 6);
+
+        FixedBuffer<FixedBufferElement, 64> c(std::move(b));
+        REQUIRE(c.size() == 3);
+        REQUIRE(c[1].value == 2);
+
+        c.pop_back();
+        REQUIRE(c.size() == 2);
+        REQUIRE(FixedBufferElement::alive == 8);
+
+        a = c;
+        REQUIRE(a.size() == 2);
+        REQUIRE(FixedBufferElement::alive == 7);
+
+        a.clear();
+        REQUIRE(a.empty());
+        REQUIRE(FixedBufferElement::alive == 5);
+    }
+    REQUIRE(FixedBufferElement::alive == 0);
+
+    static_assert(FixedBuffer<int, 3>::capacity() == 3);
+}
+
 TEST_CASE("buffer::SmallBuffer")
 {
     SmallBuffer<int, 3> buffer;
@@ -88,3 +148,31 @@ TEST_CASE("buffer::SmallBuffer")
     }
     REQUIRE(hc == 0);
 }
+
+TEST_CASE("buffer::SmallBuffer::allocator")
+{
+    Arena arena;
+
+    using Buffer = SmallBuffer<int, 2, std::pmr::polymorphic_allocator<int>>;
+
+    Buffer a(&arena);
+    for (int i = 0; i < 10; ++i)
+        a.push_back(i);
+
+    REQUIRE(a.size() == 10);
+    REQUIRE(a.get_allocator().resource() == &arena);
+
+    Buffer b(std::move(a));
+    REQUIRE(b.size() == 10);
+    REQUIRE(b[9] == 9);
+    REQUIRE(a.size() == 0);
+
+    Buffer c;
+    c = std::move(b);
+    REQUIRE(c.size() == 10);
+    REQUIRE(c.get_allocator().resource() != &arena);
+
+    SmallBuffer<std::string, 1> d = { "a", "b", "c" };
+    SmallBuffer<std::string, 1> e(d);
+    REQUIRE(e[2] == "c");
+}
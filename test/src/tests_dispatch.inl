@@ -0,0 +1,103 @@
+struct Square
+{
+    template<std::size_t kIndex>
+    static int handle(int value)
+    {
+        return static_cast<int>(kIndex * kIndex) + value;
+    }
+};
+
+TEST_CASE("JumpTable")
+{
+    using Table = JumpTable<300, Square, int(int)>;
+
+    static_assert(Table::size() == 300);
+    static_assert(Table::kTable[7] == &Square::handle<7>);
+
+    for (int i = 0; i < 300; ++i)
+        REQUIRE(Table::dispatch(i, 1) == i * i + 1);
+}
+
+struct Machine
+{
+    std::vector<u8> program;
+    std::size_t pc = 0;
+    int acc = 0;
+};
+
+struct Opcode
+{
+    template<std::size_t kIndex>
+    static int handle(Machine& machine);
+};
+
+using OpcodeTable = JumpTable<256, Opcode, int(Machine&)>;
+
+template<std::size_t kIndex>
+int Opcode::handle(Machine& machine)
+{
+    if constexpr (kIndex == 0)
+        return machine.acc;
+    else if constexpr (kIndex < 128)
+        machine.acc += static_cast<int>(kIndex);
+    else
+        machine.acc -= static_cast<int>(kIndex - 127);
+
+#if SHELL_HAS_MUSTTAIL
+    SHELL_MUSTTAIL return OpcodeTable::kTable[machine.program[machine.pc++]](machine);
+#else
+    return machine.acc;
+#endif
+}
+
+int run(Machine& machine)
+{
+    int acc = OpcodeTable::dispatch(machine.program[machine.pc++], machine);
+#if !SHELL_HAS_MUSTTAIL
+    // Trampoline until the halting opcode.
+    while (machine.program[machine.pc - 1] != 0)
+        acc = OpcodeTable::dispatch(machine.program[machine.pc++], machine);
+#endif
+    return acc;
+}
+
+TEST_CASE("JumpTable::threaded")
+{
+    Machine machine;
+    for (int i = 0; i < 1000; ++i)
+        machine.program.push_back(static_cast<u8>(i % 2 ? 1 + i % 127 : 128 + i % 128));
+    machine.program.push_back(0);
+
+    int expected = 0;
+    for (std::size_t i = 0; i + 1 < machine.program.size(); ++i)
+    {
+        int op = machine.program[i];
+        expected += op < 128 ? op : -(op - 127);
+    }
+
+    REQUIRE(run(machine) == expected);
+    REQUIRE(machine.pc == machine.program.size());
+}
+
+TEST_CASE("dispatch")
+{
+    int calls = 0;
+    for (std::size_t i = 0; i < 512; ++i)
+    {
+        std::size_t value = dispatch<512>(i, [&](auto kIndex) -> std::size_t
+        {
+            calls++;
+            constexpr std::size_t kTwice = 2 * kIndex;
+            return kTwice;
+        });
+        REQUIRE(value == 2 * i);
+    }
+    REQUIRE(calls == 512);
+
+    bool visited = false;
+    dispatch<4>(3, [&](auto kIndex)
+    {
+        visited = kIndex == 3;
+    });
+    REQUIRE(visited);
+}
@@ -3,3 +3,41 @@ TEST_CASE("format")
     REQUIRE(format(10) == "10");
     REQUIRE(format("{}") == "{}");
 }
+
+TEST_CASE("format::compiled")
+{
+    REQUIRE(format(SHELL_FORMAT("{{}}")) == "{}");
+    REQUIRE(format(SHELL_FORMAT("{} {:>3}"), 1, "a") == "1   a");
+    REQUIRE(format(SHELL_FORMAT("{:.2f}"), 0.5) == "0.50");
+    REQUIRE(format(FMT_STRING("{:x}"), 255) == "ff");
+    REQUIRE(detail::formatView(SHELL_FORMAT("{} {}")) == "{} {}");
+
+    print(SHELL_FORMAT("{} {}\n"), "compiled", 1);
+    print(fmt::fg(fmt::rgb(97, 214, 214)), SHELL_FORMAT("{} {}\n"), "styled", 2);
+    print(SHELL_FORMAT("plain\n"));
+}
+
+TEST_CASE("format::formatTo")
+{
+    fmt::memory_buffer memory;
+    REQUIRE(formatTo(memory, "{} {}", 1, 2) == 3);
+    REQUIRE(formatTo(memory, SHELL_FORMAT(" {}"), "x") == 2);
+    REQUIRE(formatTo(memory, "{}") == 2);
+    REQUIRE(fmt::to_string(memory) == "1 2 x{}");
+
+    std::string string = "a";
+    REQUIRE(formatTo(string, SHELL_FORMAT("{:>3}"), 7) == 3);
+    REQUIRE(string == "a  7");
+
+    SmallBuffer<char, 4> small;
+    REQUIRE(formatTo(small, "{}-{}", 123, 456) == 7);
+    REQUIRE(std::string(small.begin(), small.end()) == "123-456");
+
+    FixedBuffer<char, 8> fixed;
+    REQUIRE(formatTo(fixed, "{}", 12345) == 5);
+    REQUIRE(formatTo(fixed, SHELL_FORMAT("{}"), 6789) == 4);
+    REQUIRE(fixed.size() == 8);
+    REQUIRE(std::string(fixed.begin(), fixed.end()) == "12345678");
+    REQUIRE(formatTo(fixed, "{}", 0) == 1);
+    REQUIRE(fixed.size() == 8);
+}
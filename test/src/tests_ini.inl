@@ -96,6 +96,78 @@ TEST_CASE("Ini::parse")
     REQUIRE(!ini.find<int>("test", "value3").has_value());
 }
 
+TEST_CASE("Ini::resource")
+{
+    Arena arena(1024, std::pmr::null_memory_resource());
+
+    std::pmr::monotonic_buffer_resource upstream;
+    Arena scoped(1024, &upstream);
+
+    Ini ini(&scoped);
+    ini.parse("[test]\nvalue = 1\n# Comment\n");
+    ini.set("test", "other", "2");
+
+    REQUIRE(*ini.find<int>("test", "value") == 1);
+    REQUIRE(*ini.find<int>("test", "other") == 2);
+    REQUIRE_THROWS_AS(Ini(&arena).parse("[test]"), std::bad_alloc);
+}
+
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+    std::size_t characters = 0;
+
+protected:
+    void* do_allocate(std::size_t size, std::size_t align) override
+    {
+        allocations++;
+        characters += align == alignof(char);
+        return std::pmr::new_delete_resource()->allocate(size, align);
+    }
+
+    void do_deallocate(void* data, std::size_t size, std::size_t align) override
+    {
+        std::pmr::new_delete_resource()->deallocate(data, size, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("Ini::resource::reuse")
+{
+    std::string data = "# A comment that does not fit into a small string\n";
+    for (int i = 0; i < 100; ++i)
+        data += shell::format("[section_with_a_long_name_{}]\nkey_with_a_long_name_{} = value that does not fit either {}\n", i, i, i);
+
+    CountingResource counting;
+    Ini(&counting).parse(data);
+    REQUIRE(counting.characters == 301);
+
+    counting.allocations = 0;
+    std::pmr::unsynchronized_pool_resource pool(&counting);
+
+    Ini ini(&pool);
+    ini.parse(data);
+    std::size_t warm = counting.allocations;
+    REQUIRE(warm > 0);
+
+    for (int i = 0; i < 10; ++i)
+        ini.parse(data);
+
+    REQUIRE(counting.allocations == warm);
+    REQUIRE(*ini.find<std::string>("section_with_a_long_name_99", "key_with_a_long_name_99") == "value that does not fit either 99");
+
+    CountingResource global;
+    std::pmr::set_default_resource(&global);
+    ini.parse(data);
+    std::pmr::set_default_resource(nullptr);
+    REQUIRE(global.allocations == 0);
+}
+
 TEST_CASE("Ini::set")
 {
     Ini ini;
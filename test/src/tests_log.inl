@@ -21,3 +21,489 @@ TEST_CASE("logging::sinks")
 
     setSink(ColoredConsoleSink());
 }
+
+class CopyCodec : public Codec
+{
+public:
+    std::string extension() const
+    {
+        return ".copy";
+    }
+
+    bool compress(const filesystem::path& src, const filesystem::path& dst)
+    {
+        std::error_code ec;
+        return filesystem::copy_file(src, dst, ec);
+    }
+};
+
+static std::size_t countFiles(const filesystem::path& dir, const std::string& extension)
+{
+    std::size_t count = 0;
+    for (const auto& entry : filesystem::directory_iterator(dir))
+    {
+        if (entry.path().extension() == extension)
+            count++;
+    }
+    return count;
+}
+
+TEST_CASE("logging::RotatingFileSink")
+{
+    filesystem::remove_all("logs");
+
+    {
+        RotatingFileSink sink("logs/size.log", { 64 }, std::make_shared<CopyCodec>(), 16);
+        for (int i = 0; i < 10; ++i)
+            sink.sink(shell::format("message {}", i), Level::Info);
+    }
+
+    std::string data;
+    REQUIRE(filesystem::read("logs/size.log", data) == filesystem::Status::Ok);
+    REQUIRE(data.size() <= 64);
+    REQUIRE(data.substr(data.size() - 14) == "[I] message 9\n");
+    REQUIRE(countFiles("logs", ".copy") == 2);
+    REQUIRE(countFiles("logs", ".log") == 1);
+
+    {
+        RotatingFileSink sink("logs/manual.log", {});
+        sink.sink("first", Level::Info);
+        sink.rotate();
+        sink.sink("second", Level::Error, "location");
+        sink.flush();
+
+        REQUIRE(filesystem::read("logs/manual.log", data) == filesystem::Status::Ok);
+        REQUIRE(data == "[E] location: second\n");
+    }
+    REQUIRE(countFiles("logs", ".log") == 3);
+
+    setSink(RotatingFileSink("logs/moved.log", {}));
+    SHELL_LOG_INFO("RotatingFileSink");
+    setSink(ColoredConsoleSink());
+
+    REQUIRE(filesystem::read("logs/moved.log", data) == filesystem::Status::Ok);
+    REQUIRE(data.find("RotatingFileSink") != std::string::npos);
+}
+
+TEST_CASE("logging::BinarySink")
+{
+    {
+        BinarySink sink("logs/binary.bin", 32);
+        for (int i = 0; i < 3; ++i)
+            SHELL_LOG_BINARY(sink, Level::Info, "value {} {:.1f} {} {}", -i, 0.5 * i, "text", i == 1);
+
+        SHELL_LOG_BINARY(sink, Level::Warn, "unsigned {:x} char {}", 255U, 'c');
+        SHELL_LOG_BINARY(sink, Level::Error, "no arguments");
+        sink.sink("plain", Level::Debug);
+        sink.sink("located", Level::Fatal, "location");
+    }
+
+    std::vector<u8> data;
+    REQUIRE(filesystem::read("logs/binary.bin", data) == filesystem::Status::Ok);
+
+    BinaryLogReader reader(data);
+    REQUIRE(reader.valid());
+
+    std::vector<std::string> lines;
+    BinaryLogReader::Record record;
+    while (reader.next(record))
+        lines.push_back(BinaryLogReader::render(record));
+
+    REQUIRE(reader.valid());
+    REQUIRE(lines.size() == 7);
+    REQUIRE(lines[0].find("[I] ") == 0);
+    REQUIRE(lines[0].find(": value 0 0.0 text false") != std::string::npos);
+    REQUIRE(lines[1].find(": value -1 0.5 text true") != std::string::npos);
+    REQUIRE(lines[2].find(": value -2 1.0 text false") != std::string::npos);
+    REQUIRE(lines[3].find("[W] ") == 0);
+    REQUIRE(lines[3].find(": unsigned ff char c") != std::string::npos);
+    REQUIRE(lines[4].find(": no arguments") != std::string::npos);
+    REQUIRE(lines[5] == "[D] plain");
+    REQUIRE(lines[6] == "[F] location: located");
+
+    data.resize(data.size() - 1);
+    BinaryLogReader truncated(data);
+    while (truncated.next(record));
+    REQUIRE(!truncated.valid());
+}
+
+TEST_CASE("logging::BinarySink::setSink")
+{
+    {
+        BinarySink sink("logs/routed.bin");
+        setSink(sink);
+
+        for (int i = 0; i < 2; ++i)
+            SHELL_LOG_INFO("routed {} {} {}", i, "text", 0.5);
+        SHELL_LOG_BINARY(sink, Level::Warn, "copy {}", 2);
+        shell::error("runtime {}", 3);
+
+        auto console = std::make_shared<ColoredConsoleSink>();
+        setSink(console);
+        REQUIRE(getSink() == console);
+    }
+
+    std::vector<u8> data;
+    REQUIRE(filesystem::read("logs/routed.bin", data) == filesystem::Status::Ok);
+
+    // Macros store their arguments, only the runtime call is formatted.
+    std::string raw(data.begin(), data.end());
+    REQUIRE(raw.find("routed {} {} {}") != std::string::npos);
+    REQUIRE(raw.find("routed 0") == std::string::npos);
+    REQUIRE(raw.find("runtime 3") != std::string::npos);
+
+    BinaryLogReader reader(data);
+    std::vector<std::string> messages;
+    BinaryLogReader::Record record;
+    while (reader.next(record))
+        messages.push_back(record.message);
+
+    REQUIRE(reader.valid());
+    REQUIRE(messages == std::vector<std::string>{ "routed 0 text 0.5", "routed 1 text 0.5", "copy 2", "runtime 3" });
+}
+
+class CollectSink : public BasicSink
+{
+public:
+    CollectSink(std::shared_ptr<std::vector<LogRecord>> records)
+        : _records(std::move(records)) {}
+
+    void sink(const std::string& message, Level level)
+    {
+        sink(LogRecord(level, message));
+    }
+
+    void sink(const std::string& message, Level level, const std::string& location)
+    {
+        sink(LogRecord(level, message, location));
+    }
+
+    void sink(const LogRecord& record)
+    {
+        _records->push_back(record);
+    }
+
+private:
+    std::shared_ptr<std::vector<LogRecord>> _records;
+};
+
+class CountSink : public BasicSink
+{
+public:
+    CountSink(std::shared_ptr<std::atomic<std::size_t>> count)
+        : _count(std::move(count)) {}
+
+    void sink(const std::string&, Level)
+    {
+        _count->fetch_add(1);
+    }
+
+    void sink(const std::string&, Level, const std::string&)
+    {
+        _count->fetch_add(1);
+    }
+
+private:
+    std::shared_ptr<std::atomic<std::size_t>> _count;
+};
+
+TEST_CASE("logging::LogRecord")
+{
+    LogRecord a(Level::Info, "a");
+    LogRecord b(Level::Warn, "b", "location");
+    REQUIRE(a.time <= b.time);
+    REQUIRE(a.thread == b.thread);
+    REQUIRE(b.location == "location");
+
+    u32 thread = 0;
+    std::thread([&]() { thread = LogRecord(Level::Info, "c").thread; }).join();
+    REQUIRE(thread != a.thread);
+}
+
+TEST_CASE("logging::AsyncSink")
+{
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kRecords = 2000;
+
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    {
+        AsyncSink sink(CollectSink(records), std::chrono::milliseconds(1));
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < kThreads; ++i)
+        {
+            threads.emplace_back([&sink]()
+            {
+                for (std::size_t j = 0; j < kRecords; ++j)
+                    sink.sink(shell::format("{}", j), Level::Info);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        sink.flush();
+        REQUIRE(records->size() == kThreads * kRecords);
+
+        std::unordered_map<u32, std::size_t> next;
+        for (const auto& record : *records)
+            REQUIRE(record.message == shell::format("{}", next[record.thread]++));
+
+        sink.sink("location", Level::Error, "function");
+    }
+    REQUIRE(records->size() == kThreads * kRecords + 1);
+    REQUIRE(records->back().location == "function");
+}
+
+TEST_CASE("logging::AsyncSink::merge")
+{
+    auto records = std::make_shared<std::vector<LogRecord>>();
+
+    AsyncSink sink(CollectSink(records), std::chrono::hours(1));
+
+    auto produce = [&sink](std::size_t offset)
+    {
+        for (std::size_t i = offset; i < 100; i += 2)
+        {
+            LogRecord record(Level::Info, shell::format("{}", i));
+            record.time = LogRecord::Clock::time_point(std::chrono::nanoseconds(i));
+            sink.sink(record);
+        }
+    };
+
+    std::thread(produce, 0).join();
+    std::thread(produce, 1).join();
+
+    sink.flush();
+    REQUIRE(records->size() == 100);
+    for (std::size_t i = 0; i < records->size(); ++i)
+        REQUIRE((*records)[i].message == shell::format("{}", i));
+}
+
+TEST_CASE("logging::AsyncSink::threads")
+{
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        AsyncSink sink(CollectSink(records), std::chrono::milliseconds(1));
+        for (std::size_t j = 0; j < 50; ++j)
+            std::thread([&sink, j]() { sink.sink(shell::format("{}", j), Level::Info); }).join();
+
+        sink.sink("main", Level::Info);
+        sink.flush();
+        REQUIRE(records->size() == 51 * (i + 1));
+        REQUIRE(records->back().message == "main");
+    }
+}
+
+TEST_CASE("logging::setSink")
+{
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kRecords = 2000;
+
+    auto count = std::make_shared<std::atomic<std::size_t>>(0);
+    setSink(CountSink(count));
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < kThreads; ++i)
+    {
+        threads.emplace_back([]()
+        {
+            for (std::size_t j = 0; j < kRecords; ++j)
+                SHELL_LOG_INFO("{}", j);
+        });
+    }
+
+    for (std::size_t i = 0; i < 100; ++i)
+        setSink(CountSink(count));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    setSink(ColoredConsoleSink());
+    REQUIRE(count->load() == kThreads * kRecords);
+}
+
+TEST_CASE("logging::setSink::release")
+{
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    setSink(CollectSink(records));
+
+    std::atomic<int> step = 0;
+    std::thread thread([&step]()
+    {
+        SHELL_LOG_INFO("idle");
+        step = 1;
+        while (step != 2)
+            std::this_thread::yield();
+    });
+
+    while (step != 1)
+        std::this_thread::yield();
+
+    setSink(ColoredConsoleSink());
+    REQUIRE(records.use_count() == 1);
+    REQUIRE(records->size() == 1);
+
+    step = 2;
+    thread.join();
+}
+
+TEST_CASE("logging::setSink::spawn")
+{
+    // Starts a logging thread from inside the sink while it is replaced.
+    class SpawnSink : public BasicSink
+    {
+    public:
+        SpawnSink(std::atomic<int>& step)
+            : _step(step) {}
+
+        void sink(const std::string& message, Level level)
+        {
+            u64 version = detail::sinkVersion.load();
+            _step = 1;
+            while (detail::sinkVersion.load() == version)
+                std::this_thread::yield();
+
+            std::thread([]() { SHELL_LOG_INFO("inner"); }).join();
+        }
+
+        void sink(const std::string& message, Level level, const std::string&)
+        {
+            sink(message, level);
+        }
+
+    private:
+        std::atomic<int>& _step;
+    };
+
+    std::atomic<int> step = 0;
+    setSink(SpawnSink(step));
+
+    std::thread thread([]() { SHELL_LOG_INFO("outer"); });
+    while (step != 1)
+        std::this_thread::yield();
+
+    auto count = std::make_shared<std::atomic<std::size_t>>(0);
+    setSink(CountSink(count));
+    thread.join();
+
+    setSink(ColoredConsoleSink());
+    REQUIRE(count->load() == 1);
+}
+
+TEST_CASE("logging::limit")
+{
+    // Every limiter needs its own state per thread.
+    LimiterLocal locals[8];
+    EveryN every(10);
+    std::size_t passed = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (auto suppressed = every.pass(locals[0]))
+        {
+            REQUIRE(*suppressed == (passed == 0 ? 0 : 9));
+            passed++;
+        }
+    }
+    REQUIRE(passed == 10);
+
+    std::thread([&every]()
+    {
+        LimiterLocal other;
+        REQUIRE(every.pass(other) == 0);
+        REQUIRE(!every.pass(other));
+    }).join();
+
+    EveryInterval interval(std::chrono::hours(1));
+    REQUIRE(interval.pass(locals[1]) == 0);
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(!interval.pass(locals[1]));
+
+    TokenBucket bucket(1e-3, 5);
+    passed = 0;
+    for (int i = 0; i < 100; ++i)
+        passed += bucket.pass(locals[2]).has_value();
+    REQUIRE(passed == 5);
+
+    TokenBucket slow(1e-300, std::numeric_limits<u64>::max());
+    REQUIRE(slow.pass(locals[3]) == 0);
+
+    TokenBucket fast(1e300, 1);
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(fast.pass(locals[4]) == 0);
+
+    Sampler never(0.0);
+    Sampler always(1.0);
+    Sampler half(0.5);
+    passed = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        REQUIRE(!never.pass(locals[5]));
+        REQUIRE(always.pass(locals[6]) == 0);
+        passed += half.pass(locals[7]).has_value();
+    }
+    REQUIRE(passed > 4000);
+    REQUIRE(passed < 6000);
+}
+
+TEST_CASE("logging::limit::macros")
+{
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    setSink(CollectSink(records));
+
+    for (int i = 0; i < 25; ++i)
+    {
+        SHELL_LOG_ERROR_EVERY_N(10, "every {}", i);
+        SHELL_LOG_EVERY_MS(Level::Error, 3600000, "interval {}", i);
+        SHELL_LOG_RATE(Level::Error, 1e-3, 2, "rate {}", i);
+        SHELL_LOG_ERROR_SAMPLE(0.0, "never {}", i);
+        SHELL_LOG_WARN_EVERY_N(25 - i, "once {}", i);
+    }
+    setSink(ColoredConsoleSink());
+
+    std::vector<std::string> messages;
+    for (const auto& record : *records)
+        messages.push_back(record.message);
+
+    REQUIRE(messages == std::vector<std::string>{
+        "every 0",
+        "interval 0",
+        "rate 0",
+        "once 0",
+        "rate 1",
+        "every 10 (9 suppressed)",
+        "every 20 (9 suppressed)"
+    });
+}
+
+TEST_CASE("logging::compiled")
+{
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    setSink(CollectSink(records));
+
+    SHELL_LOG_INFO(SHELL_FORMAT("compiled {}"), 1);
+    shell::warn(SHELL_FORMAT("compiled {:>2}"), 2);
+    shell::error(SHELL_FORMAT("{{}}"));
+    SHELL_LOG_EVERY_N(Level::Info, 1, SHELL_FORMAT("limited {}"), 3);
+    setSink(ColoredConsoleSink());
+
+    REQUIRE(records->size() == 4);
+    REQUIRE((*records)[0].message == "compiled 1");
+    REQUIRE((*records)[1].message == "compiled  2");
+    REQUIRE((*records)[2].message == "{}");
+    REQUIRE((*records)[3].message == "limited 3");
+
+    {
+        BinarySink sink("logs/compiled.bin");
+        SHELL_LOG_BINARY(sink, Level::Info, SHELL_FORMAT("compiled {}"), 4);
+    }
+
+    std::vector<u8> data;
+    REQUIRE(filesystem::read("logs/compiled.bin", data) == filesystem::Status::Ok);
+
+    BinaryLogReader reader(data);
+    BinaryLogReader::Record record;
+    REQUIRE(reader.next(record));
+    REQUIRE(record.message == "compiled 4");
+}
@@ -0,0 +1,80 @@
+TEST_CASE("Arena")
+{
+    Arena arena(256);
+
+    auto* a = static_cast<u8*>(arena.allocate(10, 1));
+    auto* b = static_cast<u64*>(arena.allocate(sizeof(u64), alignof(u64)));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % alignof(u64) == 0);
+    REQUIRE(reinterpret_cast<u8*>(b) >= a + 10);
+
+    auto* c = static_cast<u8*>(arena.allocate(1000, 64));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 64 == 0);
+    std::memset(c, 0xFF, 1000);
+
+    auto* point = arena.create<std::pair<int, int>>(1, 2);
+    REQUIRE(point->second == 2);
+}
+
+TEST_CASE("Arena::rewind")
+{
+    Arena arena(128);
+
+    REQUIRE(arena.allocate(16));
+    auto marker = arena.mark();
+
+    void* first = arena.allocate(16);
+    for (int i = 0; i < 20; ++i)
+        REQUIRE(arena.allocate(64));
+
+    arena.rewind(marker);
+    REQUIRE(arena.allocate(16) == first);
+
+    arena.reset();
+    void* reused = arena.allocate(64);
+    arena.reset();
+    REQUIRE(arena.allocate(64) == reused);
+
+    arena.release();
+    REQUIRE(arena.allocate(8) != nullptr);
+}
+
+TEST_CASE("Arena::pmr")
+{
+    Arena arena;
+
+    std::pmr::vector<std::pmr::string> values(&arena);
+    for (int i = 0; i < 100; ++i)
+        values.emplace_back(std::to_string(i) + " is a string that does not fit the small buffer");
+
+    REQUIRE(values[42].substr(0, 2) == "42");
+    REQUIRE(values[42].get_allocator().resource() == &arena);
+    REQUIRE(arena.is_equal(arena));
+
+    Arena other;
+    REQUIRE(!arena.is_equal(other));
+}
+
+TEST_CASE("Pool")
+{
+    Pool<std::string> pool(4);
+
+    std::vector<std::string*> values;
+    for (int i = 0; i < 10; ++i)
+        values.push_back(pool.create(std::to_string(i)));
+
+    REQUIRE(*values[7] == "7");
+
+    std::string* freed = values[3];
+    pool.destroy(freed);
+    REQUIRE(pool.create("x") == freed);
+    REQUIRE(*freed == "x");
+
+    for (auto* value : values)
+        pool.destroy(value);
+
+    struct alignas(32) Aligned { u8 x; };
+
+    Pool<Aligned> aligned;
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(reinterpret_cast<std::uintptr_t>(aligned.allocate()) % 32 == 0);
+}
@@ -0,0 +1,132 @@
+TEST_CASE("metrics::Counter")
+{
+    metrics::Counter counter;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&counter]()
+        {
+            for (int j = 0; j < 10000; ++j)
+                counter.add();
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    counter.add(5);
+    REQUIRE(counter.value() == 40005);
+
+    metrics::Gauge gauge;
+    gauge.set(10);
+    gauge.add(5);
+    gauge.sub(20);
+    REQUIRE(gauge.value() == -5);
+}
+
+TEST_CASE("metrics::Histogram")
+{
+    using Snapshot = metrics::HistogramSnapshot;
+
+    for (u64 value : { 0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 31ULL, 32ULL, 33ULL, 1000ULL, 123456789ULL, ~0ULL >> 1, ~0ULL })
+    {
+        std::size_t bucket = Snapshot::bucket(value);
+        REQUIRE(bucket < Snapshot::kBuckets);
+        REQUIRE(Snapshot::lower(bucket) <= value);
+        REQUIRE(Snapshot::upper(bucket) >= value);
+        REQUIRE(Snapshot::upper(bucket) - Snapshot::lower(bucket) <= value / 16);
+    }
+
+    for (std::size_t bucket = 1; bucket < Snapshot::kBuckets; ++bucket)
+        REQUIRE(Snapshot::lower(bucket) == Snapshot::upper(bucket - 1) + 1);
+
+    metrics::Histogram histogram;
+    for (u64 i = 1; i <= 1000; ++i)
+        histogram.record(i);
+    histogram.record(std::chrono::microseconds(5));
+
+    auto snapshot = histogram.snapshot();
+    REQUIRE(snapshot.count == 1001);
+    REQUIRE(snapshot.sum == 500500 + 5000);
+    REQUIRE(snapshot.percentile(0) == 1);
+    REQUIRE(snapshot.percentile(50) >= 500);
+    REQUIRE(snapshot.percentile(50) <= 500 * 17 / 16);
+    REQUIRE(snapshot.percentile(99) >= 990);
+    REQUIRE(snapshot.percentile(100) == 5000);
+    REQUIRE(snapshot.min == 1);
+    REQUIRE(snapshot.max == 5000);
+
+    metrics::Histogram single;
+    single.record(100);
+    REQUIRE(single.snapshot().percentile(0) == 100);
+    REQUIRE(single.snapshot().percentile(99) == 100);
+
+    Snapshot other;
+    other.buckets[Snapshot::bucket(2000)] = 1001;
+    other.count = 1001;
+    other.sum = 2002000;
+    snapshot.merge(other);
+    REQUIRE(snapshot.count == 2002);
+    REQUIRE(snapshot.percentile(40) <= 1000);
+    REQUIRE(snapshot.percentile(60) >= 2000);
+    REQUIRE(Snapshot().percentile(50) == 0);
+}
+
+TEST_CASE("metrics::Registry")
+{
+    metrics::Registry registry;
+    registry.counter("requests_total").add(3);
+    registry.gauge("connections").set(-2);
+    registry.histogram("latency_ns").record(100);
+
+    REQUIRE(&registry.counter("requests_total") == &registry.counter("requests_total"));
+    REQUIRE(registry.counter("requests_total").value() == 3);
+
+    auto snapshot = registry.snapshot();
+    std::string text = snapshot.toText();
+    REQUIRE(text.find("# TYPE requests_total counter\nrequests_total 3\n") != std::string::npos);
+    REQUIRE(text.find("# TYPE connections gauge\nconnections -2\n") != std::string::npos);
+    REQUIRE(text.find("latency_ns{quantile=\"0.99\"} 100\n") != std::string::npos);
+    REQUIRE(text.find("latency_ns_sum 100\nlatency_ns_count 1\n") != std::string::npos);
+
+    auto records = std::make_shared<std::vector<LogRecord>>();
+    CollectSink sink(records);
+    snapshot.sink(sink, Level::Warn);
+    REQUIRE(records->size() == 3);
+    REQUIRE(records->at(0).message == "requests_total 3");
+    REQUIRE(records->at(0).level == Level::Warn);
+    REQUIRE(records->at(0).location == "metrics");
+    REQUIRE(records->at(2).message.find("latency_ns count=1 mean=100.0 p50=100") == 0);
+}
+
+#if !SHELL_OS_WINDOWS
+
+TEST_CASE("metrics::Server")
+{
+    metrics::Registry registry;
+    registry.counter("served").add(7);
+
+    std::string path = fmt::format("/tmp/shell-metrics-{}.sock", ::getpid());
+    metrics::Server server(path, registry);
+    REQUIRE(server.listening());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size());
+        REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+        std::string text;
+        char data[256];
+        ssize_t size;
+        while ((size = ::read(fd, data, sizeof(data))) > 0)
+            text.append(data, static_cast<std::size_t>(size));
+        ::close(fd);
+
+        REQUIRE(text == "# TYPE served counter\nserved 7\n");
+    }
+}
+
+#endif
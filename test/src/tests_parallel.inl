@@ -0,0 +1,103 @@
+TEST_CASE("ThreadPool")
+{
+    ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::atomic<int> sum = 0;
+    for (int i = 1; i <= 1000; ++i)
+        pool.submit([&sum, i]() { sum += i; });
+
+    while (pool.runPending());
+    while (sum != 500500)
+        std::this_thread::yield();
+
+    REQUIRE(sum == 500500);
+}
+
+TEST_CASE("parallelForeach")
+{
+    std::vector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+
+    parallelForeach(values, [](int& value) { value *= 2; });
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+        REQUIRE(values[i] == 2 * static_cast<int>(i));
+
+    std::vector<int> empty;
+    parallelForeach(empty, [](int&) { FAIL(); });
+}
+
+TEST_CASE("parallelForeach::nested")
+{
+    ThreadPool pool(2);
+
+    std::vector<std::vector<int>> matrix(16, std::vector<int>(1000, 1));
+    parallelForeach(pool, matrix, [&pool](std::vector<int>& row)
+    {
+        parallelForeach(pool, row, [](int& value) { value++; }, 10);
+    }, 1);
+
+    for (const auto& row : matrix)
+        REQUIRE(std::all_of(row.begin(), row.end(), [](int value) { return value == 2; }));
+}
+
+TEST_CASE("parallelForeach::exception")
+{
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+
+    REQUIRE_THROWS_AS(parallelForeach(values, [](int value)
+    {
+        if (value == 500)
+            throw std::runtime_error("error");
+    }, 10), std::runtime_error);
+}
+
+TEST_CASE("parallelTransform")
+{
+    std::vector<int> values(5000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::vector<long long> squares(values.size());
+    auto end = parallelTransform(values, squares.begin(), [](int value) { return 1LL * value * value; }, 64);
+
+    REQUIRE(end == squares.end());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        REQUIRE(squares[i] == static_cast<long long>(i * i));
+}
+
+TEST_CASE("parallelReduce")
+{
+    std::vector<int> values(100000);
+    std::iota(values.begin(), values.end(), 1);
+
+    REQUIRE(parallelReduce(values, 0LL, std::plus<>{}) == 5000050000LL);
+    REQUIRE(parallelReduce(values, 0LL, std::plus<>{}, 7) == 5000050000LL);
+
+    std::vector<std::string> words = { "a", "b", "c", "d", "e", "f", "g" };
+    for (std::size_t chunk = 1; chunk <= words.size(); ++chunk)
+        REQUIRE(parallelReduce(words, std::string(">"), std::plus<>{}, chunk) == ">abcdefg");
+
+    std::vector<int> empty;
+    REQUIRE(parallelReduce(empty, 42, std::plus<>{}) == 42);
+}
+
+TEST_CASE("parallelTransformReduce")
+{
+    std::vector<int> a(1000);
+    std::vector<double> b(1000, 0.5);
+    std::iota(a.begin(), a.end(), 1);
+
+    auto product = [](const auto& pair)
+    {
+        auto [x, y] = pair;
+        return x * y;
+    };
+
+    REQUIRE(parallelTransformReduce(zip(a, b), 0.0, std::plus<>{}, product) == 250250.0);
+    REQUIRE(parallelTransformReduce(zip(a, b), 1.0, std::plus<>{}, product, 7) == 250251.0);
+
+    std::vector<std::string> words = { "a", "bb", "ccc" };
+    REQUIRE(parallelTransformReduce(words, std::size_t(0), std::plus<>{}, [](const std::string& word) { return word.size(); }, 1) == 6);
+}
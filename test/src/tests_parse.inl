@@ -56,3 +56,26 @@ TEST_CASE("parse::parse<double>")
     REQUIRE(!parse<double>("+1.01v"));
     REQUIRE(!parse<double>("+1,01"));
 }
+
+TEST_CASE("parse::parse<int>")
+{
+    REQUIRE(*parse<int>(" 42 ") == 42);
+    REQUIRE(*parse<int>("-0") == 0);
+    REQUIRE(*parse<int>("2147483647") == 2147483647);
+    REQUIRE(*parse<int>("-2147483648") == -2147483647 - 1);
+    REQUIRE(*parse<long long>("-9223372036854775808") == std::numeric_limits<long long>::min());
+    REQUIRE(!parse<int>("2147483648"));
+    REQUIRE(!parse<int>("-2147483649"));
+    REQUIRE(!parse<int>("+-1"));
+    REQUIRE(!parse<int>("--1"));
+    REQUIRE(!parse<int>(""));
+    REQUIRE(!parse<int>("0x"));
+
+    std::string_view view = "123456";
+    REQUIRE(*parse<int>(view.substr(1, 3)) == 234);
+    REQUIRE(*parse<double>(view.substr(0, 2)) == 12.0);
+    REQUIRE(*parse<bool>("TRUE"));
+    REQUIRE(!*parse<bool>("0"));
+    REQUIRE(*parse<double>("1E2") == 100.0);
+    REQUIRE(!parse<double>("1e400"));
+}
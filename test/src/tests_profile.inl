@@ -0,0 +1,87 @@
+namespace
+{
+
+void profiledFunction()
+{
+    SHELL_PROFILE_FUNCTION();
+}
+
+}  // namespace
+
+TEST_CASE("Profile")
+{
+    Profile::capture();
+    {
+        SHELL_PROFILE_SCOPE("outer");
+        for (int i = 0; i < 5000; ++i)
+        {
+            SHELL_PROFILE_SCOPE("inner \"quoted\"");
+        }
+        profiledFunction();
+    }
+
+    std::thread thread([]()
+    {
+        SHELL_PROFILE_SCOPE("thread");
+    });
+    thread.join();
+
+    Profile profile = Profile::capture();
+    REQUIRE(profile.events.size() == 5003);
+    REQUIRE(profile.names.size() == 4);
+    REQUIRE(std::is_sorted(profile.events.begin(), profile.events.end(), [](const auto& a, const auto& b) { return a.begin < b.begin; }));
+
+    const auto& outer = profile.events.front();
+    REQUIRE(profile.names[outer.name] == "outer");
+    for (const auto& event : profile.events)
+    {
+        if (profile.names[event.name] == "thread")
+        {
+            REQUIRE(event.thread != outer.thread);
+        }
+        else
+        {
+            REQUIRE(event.thread == outer.thread);
+            REQUIRE(event.begin >= outer.begin);
+            REQUIRE(event.begin + event.duration <= outer.begin + outer.duration);
+        }
+    }
+    REQUIRE(std::any_of(profile.names.begin(), profile.names.end(), [](const auto& name) { return name.find("profiledFunction") != std::string::npos; }));
+
+    REQUIRE(Profile::capture().events.empty());
+}
+
+TEST_CASE("Profile::dump")
+{
+    Profile profile;
+    profile.names = { "parse", "write \"file\"" };
+    profile.events = { { 0, 0, 1500, 250 }, { 1, 1, 2000, 1000000 }, { 0, 0, 3000, 7 } };
+
+    std::string json = profile.toChromeTrace();
+    REQUIRE(json.find(R"({"name":"parse","ph":"X","ts":1.500,"dur":0.250,"pid":0,"tid":0})") != std::string::npos);
+    REQUIRE(json.find(R"({"name":"write \"file\"","ph":"X","ts":2.000,"dur":1000.000,"pid":0,"tid":1})") != std::string::npos);
+    REQUIRE(json.find(R"("ts":3.000,"dur":0.007)") != std::string::npos);
+
+    auto binary = profile.toBinary();
+    REQUIRE(binary.size() == 44);
+
+    auto loaded = Profile::fromBinary(binary);
+    REQUIRE(loaded);
+    REQUIRE(loaded->names == profile.names);
+    REQUIRE(loaded->events.size() == 3);
+    REQUIRE(loaded->events[1].thread == 1);
+    REQUIRE(loaded->events[1].begin == 2000);
+    REQUIRE(loaded->events[1].duration == 1000000);
+    REQUIRE(loaded->events[2].begin == 3000);
+
+    binary.resize(binary.size() / 2);
+    REQUIRE(!Profile::fromBinary(binary));
+    REQUIRE(!Profile::fromBinary({ 'S', 'H', 'L', 'X', 1 }));
+
+    REQUIRE(profile.dump("profile/trace.json"));
+    REQUIRE(profile.dump("profile/trace.bin", Profile::Format::Binary));
+    REQUIRE(Profile::load("profile/trace.bin")->events.size() == 3);
+    REQUIRE(!Profile::load("profile/missing.bin"));
+
+    filesystem::remove_all("profile");
+}
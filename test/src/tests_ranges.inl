@@ -83,6 +83,184 @@ TEST_CASE("ranges::zip")
     REQUIRE(x == 4);
 }
 
+TEST_CASE("ranges::enumerate::iterator")
+{
+    std::vector<int> values = { 5, 6, 7, 8 };
+    std::list<int> list = { 5, 6, 7, 8 };
+    std::forward_list<int> forward_list = { 5, 6, 7, 8 };
+
+    auto range = enumerate(values);
+
+    static_assert(std::is_same_v<decltype(range.begin())::iterator_category, std::random_access_iterator_tag>);
+    static_assert(std::is_same_v<decltype(enumerate(list).begin())::iterator_category, std::forward_iterator_tag>);
+    static_assert(std::is_same_v<decltype(enumerate(forward_list).begin())::iterator_category, std::forward_iterator_tag>);
+
+    REQUIRE(range.end() - range.begin() == 4);
+    REQUIRE(std::get<0>(range.begin()[2]) == 2);
+    REQUIRE(std::get<1>(range.begin()[2]) == 7);
+    REQUIRE(std::get<0>(*(range.end() - 1)) == 3);
+    REQUIRE(range.begin() + 4 == range.end());
+    REQUIRE(range.begin() < range.end());
+
+    std::size_t last = 0;
+    for (auto [index, value] : enumerate(list, 1))
+        last = index;
+    REQUIRE(last == 4);
+
+    int count = 0;
+    for (auto [index, value] : enumerate(forward_list))
+    {
+        REQUIRE(value == 5 + static_cast<int>(index));
+        count++;
+    }
+    REQUIRE(count == 4);
+}
+
+TEST_CASE("ranges::zip::iterator")
+{
+    std::vector<int> x = { 1, 2, 3, 4, 5 };
+    std::array<double, 6> y = { 1.5, 2.5, 3.5, 4.5, 5.5, 6.5 };
+    std::list<int> z = { 7, 8, 9, 10, 11 };
+
+    auto range = zip(x, y);
+
+    static_assert(std::is_same_v<decltype(range.begin())::iterator_category, std::random_access_iterator_tag>);
+    static_assert(std::is_same_v<decltype(zip(x, z).begin())::iterator_category, std::forward_iterator_tag>);
+
+    REQUIRE(range.end() - range.begin() == 5);
+    REQUIRE(std::get<0>(range.begin()[3]) == 4);
+    REQUIRE(std::get<1>(range.begin()[3]) == 4.5);
+    REQUIRE(std::get<1>(*(range.end() - 1)) == 5.5);
+    REQUIRE(std::distance(range.begin(), range.end()) == 5);
+
+    std::list<int> shorter = { 7, 8, 9 };
+    REQUIRE(std::distance(zip(x, z).begin(), zip(x, z).end()) == 5);
+    REQUIRE(std::distance(zip(x, shorter).begin(), zip(x, shorter).end()) == 3);
+
+    for (auto [i, j] : zip(x, y))
+        i = static_cast<int>(2 * j);
+
+    REQUIRE(x == std::vector<int>{ 3, 5, 7, 9, 11 });
+}
+
+TEST_CASE("ranges::zip::parallel")
+{
+    std::vector<int> x(10000);
+    std::vector<long long> y(x.size());
+    std::iota(x.begin(), x.end(), 0);
+
+    parallelForeach(zip(x, y), [](auto pair)
+    {
+        auto [i, j] = pair;
+        j = 3LL * i;
+    }, 100);
+
+    for (std::size_t i = 0; i < x.size(); ++i)
+        REQUIRE(y[i] == 3LL * x[i]);
+
+    parallelForeach(enumerate(y), [](auto pair)
+    {
+        auto [index, value] = pair;
+        value = static_cast<long long>(index);
+    });
+
+    REQUIRE(parallelReduce(y, 0LL, std::plus<>{}) == 49995000);
+}
+
+template<typename Range>
+std::vector<std::vector<int>> collect(const Range& range)
+{
+    std::vector<std::vector<int>> result;
+    for (const auto& subrange : range)
+        result.emplace_back(subrange.begin(), subrange.end());
+
+    return result;
+}
+
+TEST_CASE("ranges::chunked")
+{
+    std::vector<int> values = { 1, 2, 3, 4, 5, 6, 7 };
+
+    REQUIRE(collect(chunked(values, 3)) == std::vector<std::vector<int>>{ { 1, 2, 3 }, { 4, 5, 6 }, { 7 } });
+    REQUIRE(collect(chunked(values, 7)) == std::vector<std::vector<int>>{ { 1, 2, 3, 4, 5, 6, 7 } });
+    REQUIRE(collect(chunked(values, 9)) == std::vector<std::vector<int>>{ { 1, 2, 3, 4, 5, 6, 7 } });
+
+    auto range = chunked(values, 2);
+    REQUIRE(range.end() - range.begin() == 4);
+    REQUIRE(*range.begin()[3].begin() == 7);
+    REQUIRE(range.begin()[1].begin() == values.begin() + 2);
+
+    for (auto chunk : chunked(values, 3))
+    {
+        for (auto& value : chunk)
+            value *= 2;
+    }
+    REQUIRE(values == std::vector<int>{ 2, 4, 6, 8, 10, 12, 14 });
+
+    std::vector<int> empty;
+    REQUIRE(collect(chunked(empty, 3)).empty());
+}
+
+TEST_CASE("ranges::windows")
+{
+    int values[5] = { 1, 2, 3, 4, 5 };
+
+    REQUIRE(collect(windows(values, 3)) == std::vector<std::vector<int>>{ { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 } });
+    REQUIRE(collect(windows(values, 5)) == std::vector<std::vector<int>>{ { 1, 2, 3, 4, 5 } });
+    REQUIRE(collect(windows(values, 6)).empty());
+}
+
+TEST_CASE("ranges::batched")
+{
+    std::vector<int> values = { 1, 2, 3, 4, 5, 6, 7 };
+
+    REQUIRE(collect(batched(values, 3)) == std::vector<std::vector<int>>{ { 1, 2 }, { 3, 4 }, { 5, 6, 7 } });
+    REQUIRE(collect(batched(values, 1)) == std::vector<std::vector<int>>{ { 1, 2, 3, 4, 5, 6, 7 } });
+    REQUIRE(collect(batched(values, 7)).size() == 7);
+
+    std::size_t total = 0;
+    for (auto batch : batched(values, 10))
+        total += std::distance(batch.begin(), batch.end());
+    REQUIRE(total == values.size());
+}
+
+TEST_CASE("ranges::strided")
+{
+    std::vector<int> values = { 0, 1, 2, 3, 4, 5, 6 };
+
+    REQUIRE(std::vector<int>(strided(values, 3).begin(), strided(values, 3).end()) == std::vector<int>{ 0, 3, 6 });
+    REQUIRE(std::vector<int>(strided(values, 2).begin(), strided(values, 2).end()) == std::vector<int>{ 0, 2, 4, 6 });
+    REQUIRE(std::vector<int>(strided(values, 9).begin(), strided(values, 9).end()) == std::vector<int>{ 0 });
+
+    for (auto& value : strided(values, 2))
+        value = -1;
+    REQUIRE(values == std::vector<int>{ -1, 1, -1, 3, -1, 5, -1 });
+
+    auto range = strided(values, 3);
+    REQUIRE(range.begin()[2] == -1);
+    REQUIRE(range.end() - range.begin() == 3);
+}
+
+TEST_CASE("ranges::chunked::parallel")
+{
+    std::vector<int> values(100000, 1);
+    std::vector<long long> sums((values.size() + 4095) / 4096);
+
+    parallelForeach(enumerate(sums), [&](auto pair)
+    {
+        auto [index, sum] = pair;
+        auto chunk = chunked(values, 4096).begin()[index];
+        sum = std::accumulate(chunk.begin(), chunk.end(), 0LL);
+    });
+    REQUIRE(std::accumulate(sums.begin(), sums.end(), 0LL) == 100000);
+
+    RingBuffer<int, 8> buffer;
+    for (int i = 0; i < 11; ++i)
+        buffer.write(i);
+
+    REQUIRE(collect(chunked(buffer, 3)) == std::vector<std::vector<int>>{ { 3, 4, 5 }, { 6, 7, 8 }, { 9, 10 } });
+}
+
 TEST_CASE("ranges::reversed")
 {
     int expected = 3;
@@ -73,3 +73,271 @@ TEST_CASE("RingBuffer::ForwardIterator")
     }
     REQUIRE(y == 2);
 }
+
+TEST_CASE("RingBuffer::RandomAccessIterator")
+{
+    RingBuffer<int, 5> x = { 0, 9, 3, 7, 1, 5, 2 };
+
+    REQUIRE(x.end() - x.begin() == 5);
+    REQUIRE(x.begin()[1] == 7);
+    REQUIRE(*(x.end() - 1) == 2);
+
+    std::sort(x.begin(), x.end());
+    REQUIRE(std::is_sorted(x.begin(), x.end()));
+    REQUIRE(x[0] == 1);
+    REQUIRE(x[4] == 7);
+    REQUIRE(*std::lower_bound(x.begin(), x.end(), 4) == 5);
+
+    int y = 7;
+    for (const auto& z : reversed(x))
+    {
+        REQUIRE(z <= y);
+        y = z;
+    }
+
+    const auto& c = x;
+    RingBuffer<int, 5>::const_iterator iter = x.begin();
+    REQUIRE(iter == c.begin());
+    REQUIRE(std::accumulate(c.begin(), c.end(), 0) == 1 + 2 + 3 + 5 + 7);
+}
+
+TEST_CASE("RingBuffer::linearize")
+{
+    RingBuffer<int, 6> x = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    x.read();
+
+    int* data = x.linearize();
+    REQUIRE(x.size() == 5);
+    REQUIRE(std::equal(data, data + x.size(), x.begin()));
+    REQUIRE(data[0] == 3);
+    REQUIRE(data[4] == 7);
+
+    x.write(8);
+    x.write(9);
+    REQUIRE(x.front() == 4);
+    REQUIRE(x.back() == 9);
+
+    RingBuffer<int, 8> y = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    data = y.linearize();
+    for (int i = 0; i < 8; ++i)
+        REQUIRE(data[i] == i + 3);
+}
+
+template<int kSize>
+void testRingBufferBulk()
+{
+    RingBuffer<int, kSize> x;
+
+    int values[2 * kSize];
+    for (int i = 0; i < 2 * kSize; ++i)
+        values[i] = i;
+
+    for (int offset = 0; offset < kSize; ++offset)
+    {
+        x.clear();
+        for (int i = 0; i < offset; ++i)
+        {
+            x.write(-1);
+            x.read();
+        }
+
+        x.write(values, kSize - 1);
+        REQUIRE(x.size() == kSize - 1);
+        REQUIRE(x.front() == 0);
+        REQUIRE(x.back() == kSize - 2);
+
+        x.write(values, 2 * kSize);
+        REQUIRE(x.size() == kSize);
+        REQUIRE(x.front() == kSize);
+
+        int read[kSize] = {};
+        x.read(read, kSize - 1);
+        REQUIRE(x.size() == 1);
+        REQUIRE(x.read() == 2 * kSize - 1);
+
+        for (int i = 0; i < kSize - 1; ++i)
+            REQUIRE(read[i] == kSize + i);
+    }
+}
+
+TEST_CASE("RingBuffer::bulk")
+{
+    testRingBufferBulk<3>();
+    testRingBufferBulk<4>();
+    testRingBufferBulk<7>();
+    testRingBufferBulk<8>();
+}
+
+TEST_CASE("SpscRingBuffer")
+{
+    SpscRingBuffer<int, 4> x;
+    REQUIRE(x.empty());
+    REQUIRE(x.try_push(1));
+    REQUIRE(x.try_push(2));
+    REQUIRE(x.try_push(3));
+    REQUIRE(x.try_push(4));
+    REQUIRE(!x.try_push(5));
+    REQUIRE(x.size() == 4);
+
+    int value = 0;
+    REQUIRE(x.try_pop(value));
+    REQUIRE(value == 1);
+
+    int values[4] = { 5, 6, 7, 8 };
+    REQUIRE(x.try_push(values, 4) == 1);
+
+    int popped[8] = {};
+    REQUIRE(x.try_pop(popped, 8) == 4);
+    REQUIRE(popped[0] == 2);
+    REQUIRE(popped[3] == 5);
+    REQUIRE(!x.try_pop(value));
+
+    constexpr int kCount = 100'000;
+
+    SpscRingBuffer<int, 64> y;
+    std::thread producer([&]()
+    {
+        for (int i = 0; i < kCount; ++i)
+            y.push(i);
+    });
+
+    bool ordered = true;
+    for (int i = 0; i < kCount; ++i)
+        ordered &= y.pop() == i;
+
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(y.empty());
+}
+
+TEST_CASE("MpmcRingBuffer")
+{
+    MpmcRingBuffer<int, 4> x;
+    REQUIRE(x.try_push(1));
+    REQUIRE(x.try_push(2));
+    REQUIRE(x.try_push(3));
+    REQUIRE(x.try_push(4));
+    REQUIRE(!x.try_push(5));
+
+    int value = 0;
+    REQUIRE(x.try_pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(x.size() == 3);
+
+    constexpr int kCount = 50'000;
+    constexpr int kThreads = 2;
+
+    MpmcRingBuffer<int, 64> y;
+    std::atomic<s64> sum = 0;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 1; i <= kCount; ++i)
+                y.push(i);
+        });
+        threads.emplace_back([&]()
+        {
+            s64 local = 0;
+            for (int i = 0; i < kCount; ++i)
+                local += y.pop();
+
+            sum += local;
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(sum == kThreads * (static_cast<s64>(kCount) * (kCount + 1) / 2));
+}
+
+TEST_CASE("DynamicRingBuffer")
+{
+    DynamicRingBuffer<u32> x(1000);
+    REQUIRE(x.capacity() >= 1000);
+    REQUIRE(x.empty());
+
+    const std::size_t capacity = x.capacity();
+
+    std::vector<u32> values(capacity + capacity / 2);
+    std::iota(values.begin(), values.end(), 0);
+
+    x.write(values.data(), capacity - 1);
+    x.consume(capacity - 1);
+    x.write(values.data(), capacity);
+
+    REQUIRE(x.size() == capacity);
+    REQUIRE(std::equal(x.data(), x.data() + x.size(), values.begin()));
+    REQUIRE(x.front() == 0);
+    REQUIRE(x.back() == capacity - 1);
+
+    x.write(values.data() + capacity, capacity / 2);
+    REQUIRE(x.size() == capacity);
+    REQUIRE(x.front() == capacity / 2);
+    REQUIRE(std::equal(x.begin(), x.end(), values.begin() + capacity / 2));
+
+    std::vector<u32> read(capacity / 2);
+    x.read(read.data(), read.size());
+    REQUIRE(std::equal(read.begin(), read.end(), values.begin() + capacity / 2));
+    REQUIRE(x.read() == capacity);
+
+    u32* window = x.prepare();
+    window[0] = 42;
+    window[1] = 43;
+    x.commit(2);
+    REQUIRE(x.back() == 43);
+    REQUIRE(x[x.size() - 2] == 42);
+
+    DynamicRingBuffer<u32> y(std::move(x));
+    REQUIRE(y.back() == 43);
+}
+
+TEST_CASE("DynamicRingBuffer::unmirrored")
+{
+    for (bool mirror : { true, false })
+    {
+        DynamicRingBuffer<u32> x(1000, mirror);
+        REQUIRE(x.isMirrored() == (mirror && SHELL_OS_LINUX));
+
+        const std::size_t capacity = x.capacity();
+
+        std::vector<u32> values(capacity);
+        std::iota(values.begin(), values.end(), 0);
+
+        x.write(values.data(), capacity);
+        x.consume(capacity - 2);
+        x.write(values.data(), capacity - 2);
+
+        // Modify elements on both sides of the wrap point.
+        x.front() = 1000000;
+        x[2] = 1000002;
+        for (u32& value : x)
+            value++;
+        x.back() = 42;
+
+        x.consume(2);
+        REQUIRE(x.front() == 1000003);
+        REQUIRE(x[1] == 2);
+        REQUIRE(x.back() == 42);
+
+        x[2] = 7;
+        x.write(values.data(), 4);
+        REQUIRE(x.size() == capacity);
+        REQUIRE(x[0] == 7);
+        REQUIRE(x[capacity - 5] == 42);
+        REQUIRE(x.back() == 3);
+        REQUIRE(std::equal(x.data() + 1, x.data() + capacity - 5, values.begin() + 4));
+
+        // Overwrite while the read index wraps around.
+        x.consume(capacity - 8);
+        x[6] = 99;
+        x.write(values.data(), capacity - 2);
+        REQUIRE(x.size() == capacity);
+        REQUIRE(x[0] == 99);
+        REQUIRE(x[1] == 3);
+        REQUIRE(std::equal(x.data() + 2, x.data() + capacity, values.begin()));
+    }
+}
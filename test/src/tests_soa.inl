@@ -0,0 +1,152 @@
+TEST_CASE("SoaVector")
+{
+    SoaVector<int, double, std::string> x;
+    REQUIRE(x.empty());
+
+    x.push_back({ 1, 1.5, "a" });
+    x.push_back(std::make_tuple(2, 2.5, "b"));
+    x.emplace_back(3, 3.5, "c");
+
+    REQUIRE(x.size() == 3);
+    REQUIRE(std::get<0>(x[1]) == 2);
+    REQUIRE(std::get<1>(x[1]) == 2.5);
+    REQUIRE(std::get<2>(x[1]) == "b");
+
+    std::get<2>(x[2]) = "d";
+    REQUIRE(x.data<2>()[2] == "d");
+
+    x.pop_back();
+    REQUIRE(x.size() == 2);
+
+    x.resize(4);
+    REQUIRE(x.size() == 4);
+    REQUIRE(std::get<0>(x[3]) == 0);
+    REQUIRE(std::get<2>(x[3]).empty());
+
+    x.clear();
+    REQUIRE(x.empty());
+}
+
+TEST_CASE("SoaVector::column")
+{
+    SoaVector<u8, float> x;
+    for (int i = 0; i < 1000; ++i)
+        x.emplace_back(static_cast<u8>(i), static_cast<float>(i));
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(x.data<0>()) % SoaVector<u8, float>::kAlignment == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(x.data<1>()) % SoaVector<u8, float>::kAlignment == 0);
+
+    float sum = 0;
+    for (float value : x.column<1>())
+        sum += value;
+    REQUIRE(sum == 499500);
+
+    for (auto& value : x.column<0>())
+        value = 1;
+
+    const auto& y = x;
+    REQUIRE(std::accumulate(y.column<0>().begin(), y.column<0>().end(), 0) == 1000);
+}
+
+TEST_CASE("SoaVector::rows")
+{
+    SoaVector<int, int> x;
+    for (int i = 0; i < 100; ++i)
+        x.push_back({ i, 0 });
+
+    for (auto [a, b] : x)
+        b = 2 * a;
+
+    REQUIRE(x.end() - x.begin() == 100);
+    for (std::size_t i = 0; i < x.size(); ++i)
+        REQUIRE(std::get<1>(x[i]) == 2 * static_cast<int>(i));
+
+    int expected = 99;
+    for (auto [a, b] : reversed(x))
+        REQUIRE(a == expected--);
+
+    parallelForeach(x, [](auto row)
+    {
+        auto [a, b] = row;
+        b = a + 1;
+    }, 10);
+    REQUIRE(std::get<1>(x[99]) == 100);
+}
+
+TEST_CASE("SoaVector::copy")
+{
+    SoaVector<int, std::string> x;
+    x.push_back({ 1, "a" });
+    x.push_back({ 2, "b" });
+
+    SoaVector<int, std::string> y(x);
+    REQUIRE(y.size() == 2);
+    REQUIRE(std::get<1>(y[1]) == "b");
+
+    SoaVector<int, std::string> z(std::move(x));
+    REQUIRE(x.empty());
+    REQUIRE(std::get<1>(z[0]) == "a");
+
+    x = z;
+    REQUIRE(x.size() == 2);
+    z = std::move(y);
+    REQUIRE(std::get<0>(z[1]) == 2);
+}
+
+TEST_CASE("SoaVector::alias")
+{
+    SoaVector<int, std::string> x;
+    x.emplace_back(1, std::string(64, 'a'));
+    while (x.size() < x.capacity())
+        x.emplace_back(2, "b");
+
+    x.push_back(x[0]);
+    REQUIRE(x.size() == 9);
+    REQUIRE(std::get<0>(x[8]) == 1);
+    REQUIRE(std::get<1>(x[8]) == std::string(64, 'a'));
+    REQUIRE(std::get<1>(x[0]) == std::string(64, 'a'));
+}
+
+struct SoaThrowing
+{
+    SoaThrowing() = default;
+
+    SoaThrowing(int value)
+        : value(value)
+    {
+        if (value < 0)
+            throw std::runtime_error("negative");
+    }
+
+    SoaThrowing(const SoaThrowing& other)
+        : value(other.value)
+    {
+        if (++copies == 10)
+            throw std::runtime_error("copy");
+    }
+
+    int value = 0;
+    inline static int copies = 0;
+};
+
+TEST_CASE("SoaVector::exceptions")
+{
+    SoaVector<std::string, SoaThrowing> x;
+    for (int i = 0; i < 8; ++i)
+        x.emplace_back("a", i);
+
+    REQUIRE_THROWS(x.emplace_back("b", -1));
+    REQUIRE(x.size() == 8);
+    REQUIRE(x.capacity() == 8);
+
+    SoaThrowing::copies = 5;
+    REQUIRE_THROWS(x.emplace_back("b", 8));
+    REQUIRE(x.size() == 8);
+    REQUIRE(x.capacity() == 8);
+    REQUIRE(x.data<1>()[7].value == 7);
+
+    x.emplace_back("b", 8);
+    REQUIRE(x.size() == 9);
+    REQUIRE(std::get<0>(x[8]) == "b");
+    REQUIRE(std::get<1>(x[7]).value == 7);
+}
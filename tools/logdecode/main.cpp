@@ -0,0 +1,64 @@
+#include <ctime>
+#include <vector>
+
+#include <shell/errors.h>
+#include <shell/filesystem.h>
+#include <shell/format.h>
+#include <shell/int.h>
+#include <shell/log/binary.h>
+#include <shell/main.h>
+#include <shell/options.h>
+
+using namespace shell;
+
+static std::string timestamp(std::chrono::system_clock::time_point time)
+{
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+
+    return shell::format("{:%Y-%m-%d %H:%M:%S}.{:06}", fmt::gmtime(static_cast<std::time_t>(micros / 1000000)), micros % 1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    Options options("shell-logdecode");
+    options.add({ "-t,--time", "Prefix records with their UTC timestamp" }, Options::value<bool>(false));
+    options.add({ "file", "Binary log written by BinarySink" }, Options::value<std::string>()->positional());
+
+    std::string file;
+    bool time = false;
+    try
+    {
+        OptionsResult result = options.parse(argc, argv);
+        file = *result.find<std::string>("file");
+        time = *result.find<bool>("--time");
+    }
+    catch (const ParseError& error)
+    {
+        shell::print("{}\n\n{}", error.what(), options.help());
+        return 1;
+    }
+
+    std::vector<u8> data;
+    if (filesystem::read(file, data) != filesystem::Status::Ok)
+    {
+        shell::print("Cannot read '{}'\n", file);
+        return 1;
+    }
+
+    BinaryLogReader reader(data);
+    BinaryLogReader::Record record;
+    while (reader.next(record))
+    {
+        if (time)
+            shell::print("{} {}\n", timestamp(record.time), BinaryLogReader::render(record));
+        else
+            shell::print("{}\n", BinaryLogReader::render(record));
+    }
+
+    if (!reader.valid())
+    {
+        shell::print("Malformed binary log '{}'\n", file);
+        return 1;
+    }
+    return 0;
+}